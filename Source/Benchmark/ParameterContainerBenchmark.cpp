@@ -0,0 +1,156 @@
+/*
+ * ParameterContainerBenchmark.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+/* Standard library inclusions */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/* Project specific inclusions */
+#include "Parameter/ParameterContainer.h"
+
+/* Measures the parameter lookup through the chains of the linked containers with and without the memoised resolution.
+ *
+ * The memoised lookup repeats get() of the same parameter on the same container. The lookup walking the chain alternates
+ * two containers of the same depth, so every get() misses the memo of the calling thread and searches the chain again.
+ *
+ * Usage: ParameterContainerBenchmark [readers] [lookups per reader]
+ */
+
+namespace
+{
+	using TLength = Core::Parameter<boost::units::si::length>;
+
+	struct LengthTag
+		:	public Core::IParameterTagCollection::IParameterTag
+	{
+		using ID = std::integral_constant<TIdentifier, 1>;
+
+		using TParameter = TLength;
+	};
+
+	/* Parameters not searched for, so every container of the chain has some to search through */
+	template<Core::IParameterTagCollection::IParameterTag::TIdentifier IDENTIFIER>
+	struct OtherTag
+		:	public Core::IParameterTagCollection::IParameterTag
+	{
+		using ID = std::integral_constant<TIdentifier, IDENTIFIER>;
+
+		using TParameter = TLength;
+	};
+
+	using TContainers = std::vector<std::shared_ptr<Core::ParameterContainer>>;
+
+	/* Builds the chain of Depth containers, the parameter looked up is held by the root one. Returns the leaf container,
+	 * the chain is kept alive by Chain */
+	std::shared_ptr<Core::ParameterContainer> buildChain( std::size_t Depth, TContainers & Chain )
+	{
+		for( std::size_t tLevel = 0; tLevel < Depth; ++tLevel )
+		{
+			std::shared_ptr<Core::ParameterContainer> tContainer = Core::ParameterContainer::construct();
+
+			tContainer->add<OtherTag<2>>( std::make_shared<TLength>( "a", "Other", 1.0 * boost::units::si::meter ) );
+			tContainer->add<OtherTag<3>>( std::make_shared<TLength>( "b", "Other", 1.0 * boost::units::si::meter ) );
+
+			if( Chain.empty() )
+			{
+				tContainer->add<LengthTag>( std::make_shared<TLength>( "l", "Length", 1.0 * boost::units::si::meter ) );
+			}
+			else
+			{
+				tContainer->link( Chain.back() );
+			}
+
+			Chain.push_back( tContainer );
+		}
+
+		return( Chain.back() );
+	}
+
+	std::uint64_t elapsed( std::chrono::steady_clock::time_point Start )
+	{
+		return( static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - Start ).count() ) );
+	}
+
+	/* Every reader looks the parameter up on the containers given in turn, returns time per lookup */
+	double measureLookup( const TContainers & Containers, std::size_t Readers, std::size_t Lookups )
+	{
+		std::atomic<std::uint64_t> tTime( 0 );
+		std::vector<double> tSums( Readers, 0.0 );
+		std::vector<std::thread> tReaders;
+
+		for( std::size_t tReader = 0; tReader < Readers; ++tReader )
+		{
+			tReaders.emplace_back( [&Containers, &tTime, &tSum = tSums[ tReader ], Lookups]()
+			{
+				double tReaderSum = 0.0;
+
+				std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+				for( std::size_t tLookup = 0; tLookup < Lookups; ++tLookup )
+				{
+					tReaderSum += Containers[ tLookup % Containers.size() ]->get<LengthTag>()->value();
+				}
+
+				tTime += elapsed( tStart );
+
+				/* Keeps the lookups from being optimised out */
+				tSum = tReaderSum;
+			} );
+		}
+
+		for( std::thread & tReader : tReaders )
+		{
+			tReader.join();
+		}
+
+		return( static_cast<double>( tTime.load() ) / static_cast<double>( Readers * Lookups ) );
+	}
+
+	std::size_t argument( int Count, char * Arguments[], int Index, std::size_t Default )
+	{
+		return( ( Index < Count ) ? std::max<std::size_t>( std::strtoul( Arguments[ Index ], nullptr, 10 ), 1 ) : Default );
+	}
+}
+
+int main( int Count, char * Arguments[] )
+{
+	std::size_t tReaders = argument( Count, Arguments, 1, 1 );
+	std::size_t tLookups = argument( Count, Arguments, 2, 1000000 );
+
+	std::cout << tReaders << " readers doing " << tLookups << " lookups each" << std::endl;
+
+	std::cout << std::setw( 8 ) << "depth"
+		<< std::setw( 16 ) << "memoised"
+		<< std::setw( 16 ) << "chain walk"
+		<< std::setw( 16 ) << "speed-up" << " [ns/get]" << std::endl;
+
+	for( std::size_t tDepth : { 1, 2, 4, 8, 16 } )
+	{
+		TContainers tFirstChain;
+		TContainers tSecondChain;
+
+		TContainers tLeaf{ buildChain( tDepth, tFirstChain ) };
+		TContainers tLeaves{ tLeaf.front(), buildChain( tDepth, tSecondChain ) };
+
+		double tMemoised = measureLookup( tLeaf, tReaders, tLookups );
+		double tChainWalk = measureLookup( tLeaves, tReaders, tLookups );
+
+		std::cout << std::setw( 8 ) << tDepth
+			<< std::setw( 16 ) << std::fixed << std::setprecision( 1 ) << tMemoised
+			<< std::setw( 16 ) << tChainWalk
+			<< std::setw( 16 ) << std::setprecision( 2 ) << ( tChainWalk / tMemoised ) << std::endl;
+	}
+
+	return( EXIT_SUCCESS );
+}
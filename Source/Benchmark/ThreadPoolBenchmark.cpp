@@ -0,0 +1,572 @@
+/*
+ * ThreadPoolBenchmark.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+/* Standard library inclusions */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Project specific inclusions */
+#include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/TaskGraph.h"
+#include "ThreadPool/Future.h"
+
+/* Micro-benchmark suite of the ThreadPool scheduler.
+ *
+ * Every benchmark is run for both the queue types. The number of iterations is doubled until single run takes at
+ * least the minimal time, then the run is repeated and the mean, median and standard deviation are reported. The
+ * JSON output follows the format of Google Benchmark, so its tools (e.g. compare.py) may compare two runs.
+ *
+ * Usage: ThreadPoolBenchmark [--workers=N] [--producers=N] [--repetitions=N] [--min_time=SECONDS]
+ *                            [--filter=REGEX] [--format=console|json|csv] [--out=FILE]
+ *
+ * The pools log to the standard output, so the machine-readable formats are meant to be written to the --out file.
+ */
+
+namespace
+{
+	/* Command line options */
+	struct Options
+	{
+		std::size_t		mWorkers = Core::ThreadPool::defaultThreadCount();
+
+		std::size_t		mProducers = 4;
+
+		std::size_t		mRepetitions = 5;
+
+		double			mMinTime = 0.1;
+
+		std::string		mFilter = ".*";
+
+		std::string		mFormat = "console";
+
+		std::string		mOutput;
+	};
+
+	/* Single run of the benchmark */
+	struct Measurement
+	{
+		std::chrono::nanoseconds	mTime;
+
+		/* Number of items (jobs, rounds, graphs...) processed */
+		std::size_t					mItems;
+	};
+
+	/* Runs the benchmark with the number of iterations given */
+	using BenchmarkFunction = std::function<Measurement( Core::ThreadPool & Pool, std::size_t Iterations )>;
+
+	struct Benchmark
+	{
+		std::string					mName;
+
+		BenchmarkFunction			mFunction;
+
+		/* Serial baselines run with the pool switched to the serial mode */
+		Core::ThreadPool::ExecutionMode	mMode;
+	};
+
+	/* Report line, either single repetition or an aggregate of them */
+	struct Report
+	{
+		std::string		mName;
+
+		std::string		mRunName;
+
+		/* Empty for the single repetitions */
+		std::string		mAggregate;
+
+		std::size_t		mIterations;
+
+		std::size_t		mRepetitions;
+
+		/* Nanoseconds per iteration */
+		double			mTime;
+
+		double			mItemsPerSecond;
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	Measurement measure( Clock::time_point Start, std::size_t Items )
+	{
+		return( Measurement{ std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - Start ), Items } );
+	}
+
+	/* Keeps the CPU busy for the duration, standing for the real work of the job */
+	void spin( std::chrono::nanoseconds Duration )
+	{
+		Clock::time_point tEnd = Clock::now() + Duration;
+
+		while( Clock::now() < tEnd )
+		{}
+	}
+
+	/* Empty jobs added one by one from a thread outside of the pool */
+	Measurement addUncontended( Core::ThreadPool & Pool, std::size_t Iterations )
+	{
+		Clock::time_point tStart = Clock::now();
+
+		for( std::size_t tJob = 0; tJob < Iterations; ++tJob )
+		{
+			Pool.add( []() {} );
+		}
+
+		Pool.wait();
+
+		return( measure( tStart, Iterations ) );
+	}
+
+	/* Empty jobs added by several threads at once */
+	Measurement addContended( Core::ThreadPool & Pool, std::size_t Iterations, std::size_t Producers )
+	{
+		std::atomic<bool> tGo( false );
+		std::vector<std::thread> tProducers;
+
+		for( std::size_t tProducer = 0; tProducer < Producers; ++tProducer )
+		{
+			tProducers.emplace_back( [&Pool, &tGo, Jobs = ( Iterations + Producers - 1 ) / Producers]()
+			{
+				while( !tGo )
+				{
+					std::this_thread::yield();
+				}
+
+				for( std::size_t tJob = 0; tJob < Jobs; ++tJob )
+				{
+					Pool.add( []() {} );
+				}
+			} );
+		}
+
+		Clock::time_point tStart = Clock::now();
+
+		tGo = true;
+
+		for( std::thread & tProducer : tProducers )
+		{
+			tProducer.join();
+		}
+
+		Pool.wait();
+
+		return( measure( tStart, Producers * ( ( Iterations + Producers - 1 ) / Producers ) ) );
+	}
+
+	/* Empty jobs added by a pool worker, they go to its own queue and are stolen by the others */
+	Measurement addFromWorker( Core::ThreadPool & Pool, std::size_t Iterations )
+	{
+		Clock::time_point tStart = Clock::now();
+
+		Pool.add( [&Pool, Iterations]()
+		{
+			for( std::size_t tJob = 0; tJob < Iterations; ++tJob )
+			{
+				Pool.add( []() {} );
+			}
+		} );
+
+		Pool.wait();
+
+		return( measure( tStart, Iterations ) );
+	}
+
+	/* Round of Width jobs added at once and waited for by a thread outside of the pool */
+	Measurement fanOutFanIn( Core::ThreadPool & Pool, std::size_t Iterations, std::size_t Width )
+	{
+		std::vector<std::function<void()>> tJobs( Width, []() {} );
+
+		Clock::time_point tStart = Clock::now();
+
+		for( std::size_t tRound = 0; tRound < Iterations; ++tRound )
+		{
+			for( std::future<void> & tFuture : Pool.addBatch( tJobs.begin(), tJobs.end() ) )
+			{
+				tFuture.wait();
+			}
+		}
+
+		return( measure( tStart, Iterations ) );
+	}
+
+	/* Job splitting itself into two sub-jobs down to the Depth, every job waits for its sub-jobs (helping meanwhile) */
+	void split( Core::ThreadPool & Pool, std::size_t Depth )
+	{
+		if( Depth == 0 )
+		{
+			return;
+		}
+
+		std::future<void> tLeft = Pool.add( split, std::ref( Pool ), Depth - 1 );
+		std::future<void> tRight = Pool.add( split, std::ref( Pool ), Depth - 1 );
+
+		Pool.get( tLeft );
+		Pool.get( tRight );
+	}
+
+	Measurement nestedWait( Core::ThreadPool & Pool, std::size_t Iterations, std::size_t Depth )
+	{
+		Clock::time_point tStart = Clock::now();
+
+		for( std::size_t tTree = 0; tTree < Iterations; ++tTree )
+		{
+			Pool.add( split, std::ref( Pool ), Depth ).wait();
+		}
+
+		return( measure( tStart, Iterations ) );
+	}
+
+	/* Task graph of the same shape as built by the chain of ComponentModelModifier decorators. Every modifier shape
+	 * is constructed in parallel with the modified model, then applied to it */
+	Measurement modifierChain( Core::ThreadPool & Pool, std::size_t Iterations, std::size_t Modifiers, std::chrono::nanoseconds Work )
+	{
+		Clock::time_point tStart = Clock::now();
+
+		for( std::size_t tModel = 0; tModel < Iterations; ++tModel )
+		{
+			Core::TaskGraph tGraph( Pool );
+
+			Core::TaskGraph::Node<int> tModelNode = tGraph.add( [Work]() { spin( Work ); return( 0 ); } );
+
+			for( std::size_t tModifier = 0; tModifier < Modifiers; ++tModifier )
+			{
+				Core::TaskGraph::Node<int> tModifierNode = tGraph.add( [Work]() { spin( Work ); return( 1 ); } );
+
+				tModelNode = tGraph.add( [Work]( int & Model, int & Modifier ) { spin( Work ); return( Model + Modifier ); }, tModelNode, tModifierNode );
+			}
+
+			Core::Future<int> tResult = tModelNode.getFuture();
+
+			tGraph.run();
+			tResult.get();
+		}
+
+		return( measure( tStart, Iterations ) );
+	}
+
+	double mean( const std::vector<double> & Values )
+	{
+		double tSum = 0.0;
+
+		for( double tValue : Values )
+		{
+			tSum += tValue;
+		}
+
+		return( tSum / static_cast<double>( Values.size() ) );
+	}
+
+	double median( std::vector<double> Values )
+	{
+		std::sort( Values.begin(), Values.end() );
+
+		std::size_t tMiddle = Values.size() / 2;
+
+		return( ( Values.size() % 2 ) ? Values[ tMiddle ] : ( ( Values[ tMiddle - 1 ] + Values[ tMiddle ] ) / 2.0 ) );
+	}
+
+	double deviation( const std::vector<double> & Values )
+	{
+		if( Values.size() < 2 )
+		{
+			return( 0.0 );
+		}
+
+		double tMean = mean( Values );
+		double tSum = 0.0;
+
+		for( double tValue : Values )
+		{
+			tSum += ( tValue - tMean ) * ( tValue - tMean );
+		}
+
+		return( std::sqrt( tSum / static_cast<double>( Values.size() - 1 ) ) );
+	}
+
+	/* Finds the number of iterations taking at least the minimal time, then repeats the run */
+	std::vector<Report> run( Core::ThreadPool & Pool, const Benchmark & Run, const Options & Settings )
+	{
+		Pool.setExecutionMode( Run.mMode );
+
+		std::chrono::nanoseconds tMinTime = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::duration<double>( Settings.mMinTime ) );
+		std::size_t tIterations = 1;
+
+		/* The first run warms the pool up as well */
+		while( ( Run.mFunction( Pool, tIterations ).mTime < tMinTime ) && ( tIterations < ( std::size_t( 1 ) << 30 ) ) )
+		{
+			tIterations *= 2;
+		}
+
+		std::vector<Report> tReports;
+		std::vector<double> tTimes;
+		std::vector<double> tRates;
+
+		for( std::size_t tRepetition = 0; tRepetition < Settings.mRepetitions; ++tRepetition )
+		{
+			Measurement tMeasurement = Run.mFunction( Pool, tIterations );
+
+			double tNanoseconds = static_cast<double>( tMeasurement.mTime.count() );
+
+			tTimes.push_back( tNanoseconds / static_cast<double>( tIterations ) );
+			tRates.push_back( 1e9 * static_cast<double>( tMeasurement.mItems ) / tNanoseconds );
+
+			tReports.push_back( Report{ Run.mName, Run.mName, std::string(), tIterations, Settings.mRepetitions, tTimes.back(), tRates.back() } );
+		}
+
+		tReports.push_back( Report{ Run.mName + "_mean", Run.mName, "mean", tIterations, Settings.mRepetitions, mean( tTimes ), mean( tRates ) } );
+		tReports.push_back( Report{ Run.mName + "_median", Run.mName, "median", tIterations, Settings.mRepetitions, median( tTimes ), median( tRates ) } );
+		tReports.push_back( Report{ Run.mName + "_stddev", Run.mName, "stddev", tIterations, Settings.mRepetitions, deviation( tTimes ), deviation( tRates ) } );
+
+		Pool.setExecutionMode( Core::ThreadPool::ExecutionMode::Parallel );
+
+		return( tReports );
+	}
+
+	std::vector<Benchmark> benchmarks( const std::string & Queue, const Options & Settings )
+	{
+		using Mode = Core::ThreadPool::ExecutionMode;
+
+		const std::size_t Producers = Settings.mProducers;
+		const std::chrono::nanoseconds Work = std::chrono::microseconds( 20 );
+
+		std::vector<Benchmark> tBenchmarks = {
+			{ Queue + "/add/uncontended", addUncontended, Mode::Parallel },
+			{ Queue + "/add/contended/" + std::to_string( Producers ), [Producers]( Core::ThreadPool & Pool, std::size_t Iterations ) { return( addContended( Pool, Iterations, Producers ) ); }, Mode::Parallel },
+			{ Queue + "/add/from_worker", addFromWorker, Mode::Parallel }
+		};
+
+		for( std::size_t tWidth : { 16, 256 } )
+		{
+			tBenchmarks.push_back( { Queue + "/fan_out_fan_in/" + std::to_string( tWidth ), [tWidth]( Core::ThreadPool & Pool, std::size_t Iterations ) { return( fanOutFanIn( Pool, Iterations, tWidth ) ); }, Mode::Parallel } );
+		}
+
+		tBenchmarks.push_back( { Queue + "/nested_wait/8", []( Core::ThreadPool & Pool, std::size_t Iterations ) { return( nestedWait( Pool, Iterations, 8 ) ); }, Mode::Parallel } );
+
+		/* The serial run of the same chain is the baseline of the parallel speed-up */
+		for( std::size_t tModifiers : { 1, 8 } )
+		{
+			for( Mode tMode : { Mode::Parallel, Mode::Serial } )
+			{
+				std::string tName = Queue + "/modifier_chain/" + std::to_string( tModifiers ) + ( ( tMode == Mode::Serial ) ? "/serial" : "/parallel" );
+
+				tBenchmarks.push_back( { tName, [tModifiers, Work]( Core::ThreadPool & Pool, std::size_t Iterations ) { return( modifierChain( Pool, Iterations, tModifiers, Work ) ); }, tMode } );
+			}
+		}
+
+		return( tBenchmarks );
+	}
+
+	void printConsole( std::ostream & Output, const std::vector<Report> & Reports )
+	{
+		Output << std::left << std::setw( 48 ) << "benchmark" << std::right
+			<< std::setw( 16 ) << "time [ns]"
+			<< std::setw( 14 ) << "iterations"
+			<< std::setw( 18 ) << "items/s" << std::endl;
+
+		for( const Report & tReport : Reports )
+		{
+			Output << std::left << std::setw( 48 ) << tReport.mName << std::right << std::fixed
+				<< std::setw( 16 ) << std::setprecision( 1 ) << tReport.mTime
+				<< std::setw( 14 ) << tReport.mIterations
+				<< std::setw( 18 ) << std::setprecision( 0 ) << tReport.mItemsPerSecond << std::endl;
+		}
+	}
+
+	void printCsv( std::ostream & Output, const std::vector<Report> & Reports )
+	{
+		Output << "name,aggregate,iterations,real_time,time_unit,items_per_second" << std::endl;
+
+		for( const Report & tReport : Reports )
+		{
+			Output << '"' << tReport.mName << "\"," << tReport.mAggregate << ',' << tReport.mIterations << ','
+				<< std::fixed << std::setprecision( 3 ) << tReport.mTime << ",ns," << tReport.mItemsPerSecond << std::endl;
+		}
+	}
+
+	void printJson( std::ostream & Output, const std::vector<Report> & Reports, const Options & Settings )
+	{
+		std::time_t tNow = std::time( nullptr );
+		char tDate[ 32 ];
+
+		std::strftime( tDate, sizeof( tDate ), "%Y-%m-%dT%H:%M:%S%z", std::localtime( & tNow ) );
+
+		Output << "{" << std::endl
+			<< "  \"context\": {" << std::endl
+			<< "    \"date\": \"" << tDate << "\"," << std::endl
+			<< "    \"executable\": \"ThreadPoolBenchmark\"," << std::endl
+			<< "    \"num_cpus\": " << std::thread::hardware_concurrency() << "," << std::endl
+			<< "    \"workers\": " << Settings.mWorkers << "," << std::endl
+			<< "    \"producers\": " << Settings.mProducers << "," << std::endl
+			<< "    \"repetitions\": " << Settings.mRepetitions << std::endl
+			<< "  }," << std::endl
+			<< "  \"benchmarks\": [" << std::endl;
+
+		for( std::size_t tIndex = 0; tIndex < Reports.size(); ++tIndex )
+		{
+			const Report & tReport = Reports[ tIndex ];
+
+			Output << "    {" << std::endl
+				<< "      \"name\": \"" << tReport.mName << "\"," << std::endl
+				<< "      \"run_name\": \"" << tReport.mRunName << "\"," << std::endl
+				<< "      \"run_type\": \"" << ( tReport.mAggregate.empty() ? "iteration" : "aggregate" ) << "\"," << std::endl;
+
+			if( !tReport.mAggregate.empty() )
+			{
+				Output << "      \"aggregate_name\": \"" << tReport.mAggregate << "\"," << std::endl;
+			}
+
+			Output << "      \"repetitions\": " << tReport.mRepetitions << "," << std::endl
+				<< "      \"iterations\": " << tReport.mIterations << "," << std::endl
+				<< "      \"real_time\": " << std::fixed << std::setprecision( 3 ) << tReport.mTime << "," << std::endl
+				<< "      \"cpu_time\": " << tReport.mTime << "," << std::endl
+				<< "      \"time_unit\": \"ns\"," << std::endl
+				<< "      \"items_per_second\": " << tReport.mItemsPerSecond << std::endl
+				<< "    }" << ( ( tIndex + 1 < Reports.size() ) ? "," : "" ) << std::endl;
+		}
+
+		Output << "  ]" << std::endl << "}" << std::endl;
+	}
+
+	/* Parses --name=value options, returns false on unknown option */
+	bool parse( int Count, char * Arguments[], Options & Settings )
+	{
+		for( int tIndex = 1; tIndex < Count; ++tIndex )
+		{
+			std::string tArgument( Arguments[ tIndex ] );
+			std::size_t tSeparator = tArgument.find( '=' );
+
+			if( ( tArgument.compare( 0, 2, "--" ) != 0 ) || ( tSeparator == std::string::npos ) )
+			{
+				return( false );
+			}
+
+			std::string tName = tArgument.substr( 2, tSeparator - 2 );
+			std::string tValue = tArgument.substr( tSeparator + 1 );
+
+			if( tName == "workers" )
+			{
+				Settings.mWorkers = std::max<std::size_t>( std::strtoul( tValue.c_str(), nullptr, 10 ), 1 );
+			}
+			else if( tName == "producers" )
+			{
+				Settings.mProducers = std::max<std::size_t>( std::strtoul( tValue.c_str(), nullptr, 10 ), 1 );
+			}
+			else if( tName == "repetitions" )
+			{
+				Settings.mRepetitions = std::max<std::size_t>( std::strtoul( tValue.c_str(), nullptr, 10 ), 1 );
+			}
+			else if( tName == "min_time" )
+			{
+				Settings.mMinTime = std::strtod( tValue.c_str(), nullptr );
+			}
+			else if( tName == "filter" )
+			{
+				Settings.mFilter = tValue;
+			}
+			else if( ( tName == "format" ) && ( ( tValue == "console" ) || ( tValue == "json" ) || ( tValue == "csv" ) ) )
+			{
+				Settings.mFormat = tValue;
+			}
+			else if( tName == "out" )
+			{
+				Settings.mOutput = tValue;
+			}
+			else
+			{
+				return( false );
+			}
+		}
+
+		return( true );
+	}
+}
+
+int main( int Count, char * Arguments[] )
+{
+	Options tSettings;
+
+	if( !parse( Count, Arguments, tSettings ) )
+	{
+		std::cerr << "Usage: " << Arguments[ 0 ] << " [--workers=N] [--producers=N] [--repetitions=N] [--min_time=SECONDS] [--filter=REGEX] [--format=console|json|csv] [--out=FILE]" << std::endl;
+
+		return( EXIT_FAILURE );
+	}
+
+	std::regex tFilter( tSettings.mFilter );
+	std::vector<Report> tReports;
+
+	for( Core::ThreadPool::QueueType tQueue : { Core::ThreadPool::QueueType::WorkStealing, Core::ThreadPool::QueueType::LockFree } )
+	{
+		std::string tQueueName = ( tQueue == Core::ThreadPool::QueueType::LockFree ) ? "lock_free" : "work_stealing";
+
+		std::vector<Benchmark> tBenchmarks = benchmarks( tQueueName, tSettings );
+
+		tBenchmarks.erase( std::remove_if( tBenchmarks.begin(), tBenchmarks.end(), [&tFilter]( const Benchmark & Run ) { return( !std::regex_search( Run.mName, tFilter ) ); } ), tBenchmarks.end() );
+
+		if( tBenchmarks.empty() )
+		{
+			continue;
+		}
+
+		Core::ThreadPool tPool( "benchmark", tSettings.mWorkers, tQueue );
+
+		for( const Benchmark & tBenchmark : tBenchmarks )
+		{
+			std::vector<Report> tRun = run( tPool, tBenchmark, tSettings );
+
+			/* Progress goes to the console unless the console is the report itself */
+			if( tSettings.mFormat != "console" || !tSettings.mOutput.empty() )
+			{
+				std::cerr << tBenchmark.mName << ": " << std::fixed << std::setprecision( 1 ) << tRun[ tRun.size() - 2 ].mTime << " ns" << std::endl;
+			}
+
+			tReports.insert( tReports.end(), tRun.begin(), tRun.end() );
+		}
+	}
+
+	std::ofstream tFile;
+
+	if( !tSettings.mOutput.empty() )
+	{
+		tFile.open( tSettings.mOutput );
+
+		if( !tFile )
+		{
+			std::cerr << "Cannot write " << tSettings.mOutput << std::endl;
+
+			return( EXIT_FAILURE );
+		}
+	}
+
+	std::ostream & tOutput = tSettings.mOutput.empty() ? std::cout : tFile;
+
+	if( tSettings.mFormat == "json" )
+	{
+		printJson( tOutput, tReports, tSettings );
+	}
+	else if( tSettings.mFormat == "csv" )
+	{
+		printCsv( tOutput, tReports );
+	}
+	else
+	{
+		printConsole( tOutput, tReports );
+	}
+
+	return( EXIT_SUCCESS );
+}
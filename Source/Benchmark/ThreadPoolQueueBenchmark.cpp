@@ -0,0 +1,141 @@
+/*
+ * ThreadPoolQueueBenchmark.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+/* Standard library inclusions */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Project specific inclusions */
+#include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/Statistics.h"
+
+/* Compares the submission throughput and the latency of the ThreadPool queue types.
+ *
+ * Usage: ThreadPoolQueueBenchmark [workers] [producers] [jobs per producer]
+ */
+
+namespace
+{
+	struct Result
+	{
+		/* Time spent by the producers adding the jobs, per job */
+		double				mSubmissionTime;
+
+		/* Jobs added and run per second */
+		double				mThroughput;
+
+		/* Time from the add() call to the start of the job */
+		Core::Histogram		mLatency;
+	};
+
+	std::uint64_t elapsed( std::chrono::steady_clock::time_point Start )
+	{
+		return( static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - Start ).count() ) );
+	}
+
+	/* Producers flood the pool with empty jobs */
+	void measureThroughput( Core::ThreadPool & Pool, std::size_t Producers, std::size_t Jobs, Result & Measured )
+	{
+		std::atomic<std::uint64_t> tSubmissionTime( 0 );
+		std::vector<std::thread> tProducers;
+
+		std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+		for( std::size_t tProducer = 0; tProducer < Producers; ++tProducer )
+		{
+			tProducers.emplace_back( [&Pool, &tSubmissionTime, Jobs]()
+			{
+				std::chrono::steady_clock::time_point tSubmissionStart = std::chrono::steady_clock::now();
+
+				for( std::size_t tJob = 0; tJob < Jobs; ++tJob )
+				{
+					Pool.add( []() {} );
+				}
+
+				tSubmissionTime += elapsed( tSubmissionStart );
+			} );
+		}
+
+		for( std::thread & tProducer : tProducers )
+		{
+			tProducer.join();
+		}
+
+		Pool.wait();
+
+		double tTotal = static_cast<double>( elapsed( tStart ) );
+
+		Measured.mSubmissionTime = static_cast<double>( tSubmissionTime.load() ) / static_cast<double>( Producers * Jobs );
+		Measured.mThroughput = 1e9 * static_cast<double>( Producers * Jobs ) / tTotal;
+	}
+
+	/* Single jobs added one by one, with a pause long enough for the workers to go idle in between */
+	void measureLatency( Core::ThreadPool & Pool, std::size_t Samples, Result & Measured )
+	{
+		for( std::size_t tSample = 0; tSample < Samples; ++tSample )
+		{
+			std::atomic<std::uint64_t> tLatency( 0 );
+
+			std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+			Pool.add( [&tLatency, tStart]() { tLatency = elapsed( tStart ); } );
+			Pool.wait();
+
+			Measured.mLatency.add( tLatency.load() );
+
+			std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+		}
+	}
+
+	std::size_t argument( int Count, char * Arguments[], int Index, std::size_t Default )
+	{
+		return( ( Index < Count ) ? std::max<std::size_t>( std::strtoul( Arguments[ Index ], nullptr, 10 ), 1 ) : Default );
+	}
+}
+
+int main( int Count, char * Arguments[] )
+{
+	std::size_t tWorkers = argument( Count, Arguments, 1, Core::ThreadPool::defaultThreadCount() );
+	std::size_t tProducers = argument( Count, Arguments, 2, 4 );
+	std::size_t tJobs = argument( Count, Arguments, 3, 100000 );
+
+	const std::size_t LatencySamples = 1000;
+
+	std::cout << tWorkers << " workers, " << tProducers << " producers adding " << tJobs << " jobs each" << std::endl;
+
+	std::cout << std::setw( 14 ) << "queue"
+		<< std::setw( 16 ) << "add [ns/job]"
+		<< std::setw( 16 ) << "jobs/s"
+		<< std::setw( 16 ) << "latency p50"
+		<< std::setw( 16 ) << "latency p99" << " [ns]" << std::endl;
+
+	for( Core::ThreadPool::QueueType tQueue : { Core::ThreadPool::QueueType::WorkStealing, Core::ThreadPool::QueueType::LockFree } )
+	{
+		Result tResult{};
+
+		{
+			Core::ThreadPool tPool( "benchmark", tWorkers, tQueue );
+
+			measureThroughput( tPool, tProducers, tJobs, tResult );
+			measureLatency( tPool, LatencySamples, tResult );
+		}
+
+		std::cout << std::setw( 14 ) << ( ( tQueue == Core::ThreadPool::QueueType::LockFree ) ? "lock-free" : "work stealing" )
+			<< std::setw( 16 ) << std::fixed << std::setprecision( 1 ) << tResult.mSubmissionTime
+			<< std::setw( 16 ) << std::setprecision( 0 ) << tResult.mThroughput
+			<< std::setw( 16 ) << tResult.mLatency.getPercentile( 0.5 )
+			<< std::setw( 16 ) << tResult.mLatency.getPercentile( 0.99 ) << std::endl;
+	}
+
+	return( EXIT_SUCCESS );
+}
@@ -0,0 +1,93 @@
+/*
+ * AsyncComponentModel.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_COMPONENT_ASYNCCOMPONENTMODEL_H_
+#define CORE_COMPONENT_ASYNCCOMPONENTMODEL_H_
+
+/* Standard library inclusions */
+#include <memory>
+
+/* OpenCascade inclusions */
+#include <TopoDS_Shape.hxx>
+
+/* Project specific inclusions */
+#include "ThreadPool/Coroutine.h"
+#include "ThreadPool/TaskGraph.h"
+#include "Component/IComponentModel.h"
+
+#if defined( CORE_HAS_COROUTINES )
+
+namespace Component
+{
+	/** @brief Component model constructed by coroutine
+	 *
+	 * Counterpart of ComponentModel for the models which construct the shape in several asynchronous steps. The
+	 * construction is a coroutine, which co_awaits the sub-shapes and the parameter computations instead of blocking
+	 * on them, so any number of models being constructed share the few thread pool workers.
+	 *
+	 * The model may be modified by ComponentModelModifier the same way as ComponentModel. Available to the C++20
+	 * plugins only.
+	 *
+	 * Example usage:
+	 * @code{.cpp}
+	 *      Core::Async<std::unique_ptr<TopoDS_Shape>> constructComponentModel( const std::shared_ptr<Core::ParameterContainer> Parameters, const Core::CancellationToken & Token ) const override
+	 *      {
+	 *          std::unique_ptr<TopoDS_Shape> tBody = co_await this->constructBody( Parameters );
+	 *          std::unique_ptr<TopoDS_Shape> tHole = co_await Core::ThreadPool::get_mutable_instance().add( ... ).getFuture();
+	 *
+	 *          co_return( this->cut( * tBody, * tHole, Token ) );
+	 *      }
+	 * @endcode
+	 */
+	class AsyncComponentModel
+		:	public IComponentModel
+	{
+	public:
+
+	protected:
+		AsyncComponentModel( void )
+		{}
+
+		/* Long running construction should check the Token regularly and give up once cancelled */
+		virtual Core::Async<std::unique_ptr<TopoDS_Shape>> constructComponentModel( const std::shared_ptr<Core::ParameterContainer> Parameters, const Core::CancellationToken & Token ) const = 0;
+
+		/** @brief Construct Model
+		 * Starts the construction coroutine in the thread pool and returns the future of its result.
+		 */
+		TModelFuture constructModel( const std::shared_ptr<Core::ParameterContainer> Parameters, const Core::CancellationToken & Token ) const override final
+		{
+			Core::TaskGraph tGraph( Token );
+
+			/* Take the future of the model shape before the graph is run */
+			TModelFuture tModelFuture = this->addModelConstruction( tGraph, Parameters ).getFuture();
+
+			tGraph.run();
+
+			return( tModelFuture );
+		}
+
+		/** @brief Add Model Construction
+		 * The coroutine is started by single graph node having no predecessors. The node is finished once the coroutine
+		 * is, no worker waits for it meanwhile.
+		 */
+		TModelNode addModelConstruction( Core::TaskGraph & Graph, const std::shared_ptr<Core::ParameterContainer> Parameters ) const override final
+		{
+			return( Graph.addAsync(
+				[this, Parameters, Token = Graph.getCancellationToken(), & Pool = Graph.getPool()]()
+				{
+					return( this->constructComponentModel( Parameters, Token ).start( Pool ) );
+				} ) );
+		}
+
+	private:
+
+	};
+}
+
+#endif /* CORE_HAS_COROUTINES */
+
+#endif /* CORE_COMPONENT_ASYNCCOMPONENTMODEL_H_ */
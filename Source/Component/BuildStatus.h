@@ -0,0 +1,61 @@
+/*
+ * BuildStatus.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_COMPONENT_BUILDSTATUS_H_
+#define CORE_COMPONENT_BUILDSTATUS_H_
+
+/* Standard library inclusions */
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+/* Project specific inclusions */
+#include "ThreadPool/Failure.h"
+
+namespace Component
+{
+	/**
+	 * @brief Component model build status
+	 *
+	 * Outcome of the component model updates, so the failing regenerations can be detected without parsing the
+	 * console output.
+	 */
+	struct BuildStatus
+	{
+		enum class State
+		{
+			/* No update finished yet */
+			NotBuilt,
+			/* Update is running */
+			Building,
+			/* Last update succeeded */
+			Built,
+			/* Last update failed, see mLastFailure */
+			Failed,
+			/* Last update was superseded by a newer request */
+			Cancelled,
+			/* Last update requested was not started, the thread pool does not accept jobs any more */
+			Rejected
+		};
+
+		State									mState = State::NotBuilt;
+
+		/* Number of the updates succeeded */
+		std::uint64_t							mBuilds = 0;
+
+		/* Number of the updates failed */
+		std::uint64_t							mFailures = 0;
+
+		/* Duration of the last update finished (succeeded or failed) */
+		std::chrono::milliseconds				mLastDuration = std::chrono::milliseconds::zero();
+
+		/* Failure of the last update failed (or the reason it was rejected), kept even once a later update succeeds */
+		std::optional<Core::JobFailure>			mLastFailure;
+	};
+}
+
+#endif /* CORE_COMPONENT_BUILDSTATUS_H_ */
@@ -10,6 +10,10 @@
 
 /* Standard library inclusions */
 #include <memory>
+#include <chrono>
+#include <mutex>
+#include <algorithm>
+#include <optional>
 
 /* OpenCascade inclusions */
 #include "TopoDS_Shape.hxx"
@@ -21,6 +25,9 @@
 #include "Parameter/IParameter.h"
 #include "Parameter/ParameterContainer.h"
 #include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/Future.h"
+#include "ThreadPool/Cancellation.h"
+#include "ThreadPool/Failure.h"
 
 /* Shared library support */
 #include "Core_Export.h"
@@ -52,14 +59,56 @@ namespace Component
 		 *
 		 * The goal is to run the update() method in separate task to avoid blocking of main thread. The update() method
 		 * is private and is, in fact, a receipt what to update in which order.
+		 *
+		 * Update requests are coalesced. There is at most one update queued and one update running at a time, so a burst
+		 * of parameter changes results in single update. The update running is cancelled by the newer request as its
+		 * result is outdated anyway, the queued one is started once the running one is finished.
 		 */
 		void requestUpdate( void ) override final
 		{
-			/* Prepare function pointer to update() method which is about to run in a ThreadPool */
-			std::function<void ( void )> f = std::bind( & Component<DERIVED_COMPONENT_TYPE>::update, this );
+			std::lock_guard<std::mutex> tLock( this->mUpdateMutex );
+
+			this->mLastUpdateRequest = std::chrono::steady_clock::now();
+
+			if( this->mUpdateQueued || this->mUpdatePending )
+			{
+				/* The update not started yet takes the latest parameters, nothing else to do */
+				return;
+			}
+
+			if( this->mUpdateRunning )
+			{
+				this->mUpdateCancellation.cancel();
+				this->mUpdatePending = true;
+
+				return;
+			}
+
+			this->queueUpdate( this->mUpdateDebounce );
+		}
+
+		/**
+		 * @brief Set update debounce window
+		 *
+		 * The update is not started until there is no update request for the Debounce period, so the updates requested
+		 * while the user keeps changing the parameters (e.g. dragging a slider) result in single update. Zero (default)
+		 * starts the update right away.
+		 */
+		void setUpdateDebounce( std::chrono::steady_clock::duration Debounce )
+		{
+			std::lock_guard<std::mutex> tLock( this->mUpdateMutex );
+
+			this->mUpdateDebounce = Debounce;
+		}
+
+		/**
+		 * @brief Get the outcome of the model updates
+		 */
+		BuildStatus getBuildStatus( void ) const override final
+		{
+			std::lock_guard<std::mutex> tLock( this->mUpdateMutex );
 
-			/* Run update() method in ThreadPool */
-			Core::ThreadPool::get_mutable_instance().add( f );
+			return( this->mBuildStatus );
 		}
 
 		const std::string & getName( void ) const override final
@@ -85,12 +134,17 @@ namespace Component
 				/* Initially, the component model smart pointer can be set to nullptr because the instance
 				 * is created as temporary in update() member method. Once the construction is finished there,
 				 * the temporary model is swapped with mComponentModel thus becomes valid. */
-				mComponentModel( nullptr )
+				mComponentModel( nullptr ),
+				mUpdateDebounce( std::chrono::steady_clock::duration::zero() ),
+				mUpdateNode( Core::ThreadPool::AnyNode ),
+				mUpdateQueued( false ),
+				mUpdatePending( false ),
+				mUpdateRunning( false )
 		{
 			/* Connect all the specification parameter's update signals to component construction method.
 			 * Once any of the specification parameters is updated, the whole component is recalculated.
 			 */
-			for( const std::pair<const Core::ParameterContainer::TParameterContainerKey, std::shared_ptr<Core::IParameter>> & SpecificationParameter : (* Specification) )
+			for( const Core::ParameterContainer::value_type & SpecificationParameter : Specification->snapshot() )
 			{
 				/* ...connect specification parameter to SpecificationUpdated() slot */
 				(SpecificationParameter.second)->connectUpdateSignal( std::bind( & Component<DERIVED_COMPONENT_TYPE>::requestUpdate, this ) );
@@ -109,38 +163,204 @@ namespace Component
 
 		Component( void ) = delete;
 
-		void update( void )
+		/* Queues the update to be started after the Delay. Must be called with the update mutex locked.
+		 * Once the thread pool is stopped, the update is not queued but reported Rejected in the build status. Called
+		 * from the parameter update signal as well, so it must not throw */
+		void queueUpdate( std::chrono::steady_clock::duration Delay )
+		{
+			/* The update queued previously is being re-queued or was started already, it is not queued until submitted */
+			this->mUpdateQueued = false;
+
+			Core::ThreadPool & tPool = Core::ThreadPool::get_mutable_instance();
+
+			if( tPool.isStopped() )
+			{
+				this->mBuildStatus.mState = BuildStatus::State::Rejected;
+
+				return;
+			}
+
+			/* Prepare function pointer to startUpdate() method which is about to run in a ThreadPool */
+			std::function<void ( void )> f = std::bind( & Component<DERIVED_COMPONENT_TYPE>::startUpdate, this );
+
+			/* The update is run on the NUMA node the current model was constructed on, its data is local there */
+			Core::ThreadPool::NodeHint tHint( this->mUpdateNode );
+
+			/* Run update in ThreadPool. The update is requested by the user editing the component so it is run in the
+			 * interactive lane. All the model construction jobs added by update() inherit the priority */
+			try
+			{
+				if( Delay > std::chrono::steady_clock::duration::zero() )
+				{
+					tPool.addAfter( Core::ThreadPool::Priority::Interactive, Delay, f );
+				}
+				else
+				{
+					tPool.add( Core::ThreadPool::Priority::Interactive, f );
+				}
+			}
+			/* The pool was stopped after the check above */
+			catch( const Core::Exception::InvalidThreadPoolOperation & )
+			{
+				this->mBuildStatus.mState = BuildStatus::State::Rejected;
+				this->mBuildStatus.mLastFailure = Core::JobFailure::describe( std::current_exception() );
+
+				return;
+			}
+
+			this->mUpdateQueued = true;
+		}
+
+		/* Starts the queued update, unless the debounce window was extended by a newer request meanwhile */
+		void startUpdate( void )
+		{
+			Core::CancellationToken tToken;
+
+			{
+				std::lock_guard<std::mutex> tLock( this->mUpdateMutex );
+
+				std::chrono::steady_clock::time_point tDebounceEnd = this->mLastUpdateRequest + this->mUpdateDebounce;
+				std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+
+				/* Pool being shut down flushes the updates, there is no point in waiting for further requests */
+				if( ( tNow < tDebounceEnd ) && ( !Core::ThreadPool::get_const_instance().isShuttingDown() ) )
+				{
+					this->queueUpdate( tDebounceEnd - tNow );
+
+					return;
+				}
+
+				this->mUpdateQueued = false;
+				this->mUpdateRunning = true;
+				this->mBuildStatus.mState = BuildStatus::State::Building;
+
+				this->mUpdateCancellation = Core::CancellationSource();
+
+				tToken = this->mUpdateCancellation.getToken();
+			}
+
+			this->update( tToken );
+		}
+
+		void update( const Core::CancellationToken & Token )
 		{
 #if DEBUG_CONSOLE_OUTPUT
 			std::cout << "Starting component model update" << std::endl;
+#endif
 
 			/* Start measuring time... */
-			auto Start = std::chrono::steady_clock::now();
-#endif
+			std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
 
-			std::unique_ptr<IComponentModel> tComponentModel = typename ComponentTraits<DERIVED_COMPONENT_TYPE>::TComponentModelConstructor()();
+			std::shared_ptr<IComponentModel> tComponentModel;
+			IComponentModel::TModelFuture tModelShapeFuture;
 
 			try
 			{
+				/* The temporary component model must live until its construction is finished, so the continuation keeps it */
+				tComponentModel = typename ComponentTraits<DERIVED_COMPONENT_TYPE>::TComponentModelConstructor()();
+
 				/* Construct updated model referenced by temporary component model pointer */
-				std::future<std::unique_ptr<TopoDS_Shape>> tModelShapeFuture = tComponentModel->constructModel( this->getParameters() );
+				tModelShapeFuture = tComponentModel->constructModel( this->getParameters(), Token );
+			}
+			catch( ... )
+			{
+				/* Failure is handled by finishUpdate() as any other one, so the update is finished properly */
+				Core::Promise<std::unique_ptr<TopoDS_Shape>> tFailure;
+
+				tModelShapeFuture = tFailure.getFuture();
+				tFailure.setException( std::current_exception() );
+			}
 
-				/* Wait for the model to be fully constructed */
-				tModelShapeFuture.wait();
+			/* Nothing waits for the model to be constructed, the model shape is saved by the continuation once ready */
+			tModelShapeFuture.then(
+				[this, tComponentModel, tStart, Token]( IComponentModel::TModelFuture ModelShapeFuture )
+				{
+					this->finishUpdate( ModelShapeFuture, tStart, Token );
+				} );
+		}
+
+		/**
+		 * @brief Finish component update
+		 *
+		 * Continuation of update() run once the model construction is finished (or failed). Starts the update requested
+		 * meanwhile, if any.
+		 */
+		void finishUpdate( IComponentModel::TModelFuture & ModelShapeFuture, std::chrono::steady_clock::time_point Start, const Core::CancellationToken & Token )
+		{
+			std::unique_ptr<TopoDS_Shape> tModelShape;
+			std::optional<Core::JobFailure> tFailure;
+			bool tCancelled = false;
 
-				/* Once the model shape is fully updated, save it. */
-				this->mComponentModel = tModelShapeFuture.get();
+			try
+			{
+				tModelShape = ModelShapeFuture.get();
+			}
+			catch( const Core::Exception::OperationCancelled & )
+			{
+				/* Superseded by newer update, there is nothing to save */
+				tCancelled = true;
 			}
-			catch( const Exception::Design::ModelConstructionFailed & Exception )
+			catch( ... )
 			{
-				/* TODO: Improve error handling. It should not just to print out the error message... */
-				std::cout << "Component cannot be constructed. " << Exception.what() << std::endl;
+				/* Any failure is kept in the build status, not just the ModelConstructionFailed one */
+				tFailure = Core::JobFailure::describe( std::current_exception() );
+
+				std::cout << "Component cannot be constructed. " << tFailure->mType << ": " << tFailure->mMessage << std::endl;
 			}
 
-#if DEBUG_CONSOLE_OUTPUT
-			auto Duration = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - Start );
+			std::chrono::milliseconds tDuration = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - Start );
 
-			std::cout << "Component updated in " << Duration.count() << " milliseconds using Thread Pool having " << Core::ThreadPool::get_mutable_instance().threadCount() << " worker threads." << std::endl;
+			{
+				std::lock_guard<std::mutex> tLock( this->mUpdateMutex );
+
+				/* Once the model shape is fully updated, save it. Model of the superseded update is dropped, it must not
+				 * replace the model of the newer update */
+				tCancelled = tCancelled || Token.isCancelled();
+
+				if( tCancelled )
+				{
+					this->mBuildStatus.mState = BuildStatus::State::Cancelled;
+				}
+				else if( tFailure || ( !tModelShape ) )
+				{
+					this->mBuildStatus.mState = BuildStatus::State::Failed;
+					this->mBuildStatus.mLastDuration = tDuration;
+					++( this->mBuildStatus.mFailures );
+
+					/* Construction returning no shape at all has no exception to describe */
+					if( tFailure )
+					{
+						this->mBuildStatus.mLastFailure = std::move( tFailure );
+					}
+				}
+				else
+				{
+					this->mBuildStatus.mState = BuildStatus::State::Built;
+					this->mBuildStatus.mLastDuration = tDuration;
+					++( this->mBuildStatus.mBuilds );
+
+					this->mComponentModel = std::move( tModelShape );
+					this->mUpdateNode = Core::ThreadPool::get_const_instance().currentNode();
+				}
+
+				this->mUpdateRunning = false;
+
+				if( this->mUpdatePending )
+				{
+					this->mUpdatePending = false;
+
+					/* The debounce window is counted from the last request */
+					this->queueUpdate( std::max( this->mLastUpdateRequest + this->mUpdateDebounce - std::chrono::steady_clock::now(), std::chrono::steady_clock::duration::zero() ) );
+				}
+			}
+
+			if( tCancelled )
+			{
+				return;
+			}
+
+#if DEBUG_CONSOLE_OUTPUT
+			std::cout << "Component updated in " << tDuration.count() << " milliseconds using Thread Pool having " << Core::ThreadPool::get_mutable_instance().threadCount() << " worker threads." << std::endl;
 #endif
 		}
 
@@ -150,6 +370,30 @@ namespace Component
 		std::shared_ptr<Core::ParameterContainer> mParameters;
 
 		std::shared_ptr<TopoDS_Shape> mComponentModel;
+
+		/* Guards the model and the update state below */
+		mutable std::mutex mUpdateMutex;
+
+		BuildStatus mBuildStatus;
+
+		/* Cancels the update running once a newer one is requested */
+		Core::CancellationSource mUpdateCancellation;
+
+		std::chrono::steady_clock::duration mUpdateDebounce;
+
+		std::chrono::steady_clock::time_point mLastUpdateRequest;
+
+		/* NUMA node the model was constructed on, the next update is hinted to run there */
+		std::size_t mUpdateNode;
+
+		/* Update is queued in the ThreadPool, not started yet */
+		bool mUpdateQueued;
+
+		/* Update is requested while another one is running, it is queued once the running one is finished */
+		bool mUpdatePending;
+
+		/* Update is constructing the model */
+		bool mUpdateRunning;
 	};
 }
 
@@ -10,7 +10,6 @@
 
 /* Standard library inclusions */
 #include <memory>
-#include <future>
 #include <functional>
 
 /* OpenCascade inclusions */
@@ -18,6 +17,7 @@
 
 /* Project specific inclusions */
 #include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/TaskGraph.h"
 #include "Component/IComponentModel.h"
 
 namespace Base
@@ -36,19 +36,32 @@ namespace Component
 		ComponentModel( void )
 		{}
 
-		virtual std::unique_ptr<TopoDS_Shape> constructComponentModel( const std::shared_ptr<Core::ParameterContainer> Parameters ) const = 0;
+		/* Long running construction should check the Token regularly and give up once cancelled */
+		virtual std::unique_ptr<TopoDS_Shape> constructComponentModel( const std::shared_ptr<Core::ParameterContainer> Parameters, const Core::CancellationToken & Token ) const = 0;
 
 		/** @brief Construct Model
 		 * This generic method is just used to run the constructCompoentModel in threadpool. The constructComponentModel() method must be implemented
 		 * in all the component model classes which derive this base. This layout ensures all the models are constructed in own threads.
 		 */
-		std::future<std::unique_ptr<TopoDS_Shape>> constructModel( const std::shared_ptr<Core::ParameterContainer> Parameters ) const override final
+		TModelFuture constructModel( const std::shared_ptr<Core::ParameterContainer> Parameters, const Core::CancellationToken & Token ) const override final
 		{
-			/* Prepare function pointer to constructModelModifier() method */
-			std::function<std::unique_ptr<TopoDS_Shape>(const std::shared_ptr<Core::ParameterContainer>)> f = std::bind( & ComponentModel::constructComponentModel, this, std::placeholders::_1 );
+			Core::TaskGraph tGraph( Token );
 
-			/* Run the task in thread pool and return the std::future of the result */
-			return( Core::ThreadPool::get_mutable_instance().add( f, Parameters ) );
+			/* Take the future of the model shape before the graph is run */
+			TModelFuture tModelFuture = this->addModelConstruction( tGraph, Parameters ).getFuture();
+
+			/* Run the task in thread pool and return the future of the result */
+			tGraph.run();
+
+			return( tModelFuture );
+		}
+
+		/** @brief Add Model Construction
+		 * The component model is constructed by single graph node having no predecessors.
+		 */
+		TModelNode addModelConstruction( Core::TaskGraph & Graph, const std::shared_ptr<Core::ParameterContainer> Parameters ) const override final
+		{
+			return( Graph.add( [this, Parameters, Token = Graph.getCancellationToken()]() { return( this->constructComponentModel( Parameters, Token ) ); } ) );
 		}
 
 	private:
@@ -10,7 +10,6 @@
 
 /* Standard library inclusions */
 #include <memory>
-#include <future>
 #include <functional>
 
 /* OpenCascade inclusions */
@@ -19,6 +18,7 @@
 /* Project specific inclusions */
 #include "Component/IComponentModel.h"
 #include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/TaskGraph.h"
 
 namespace Base
 {
@@ -44,32 +44,44 @@ namespace Component
 			:	mModifiedComponentModel( ComponentModel )
 		{}
 
-		virtual std::unique_ptr<TopoDS_Shape> constructModelModifier( const std::shared_ptr<Core::ParameterContainer> Parameters ) const = 0;
+		/* Long running construction should check the Token regularly and give up once cancelled */
+		virtual std::unique_ptr<TopoDS_Shape> constructModelModifier( const std::shared_ptr<Core::ParameterContainer> Parameters, const Core::CancellationToken & Token ) const = 0;
 
-		virtual std::unique_ptr<TopoDS_Shape> applyModifier( const std::shared_ptr<TopoDS_Shape> ComponentShape, const std::shared_ptr<TopoDS_Shape> ModifierShape ) const = 0;
+		virtual std::unique_ptr<TopoDS_Shape> applyModifier( const std::shared_ptr<TopoDS_Shape> ComponentShape, const std::shared_ptr<TopoDS_Shape> ModifierShape, const Core::CancellationToken & Token ) const = 0;
 
 	private:
-		std::future<std::unique_ptr<TopoDS_Shape>> constructModel( const std::shared_ptr<Core::ParameterContainer> Parameters ) const override final
+		TModelFuture constructModel( const std::shared_ptr<Core::ParameterContainer> Parameters, const Core::CancellationToken & Token ) const override final
 		{
-			/* This must be called first in order to keep proper construction flow.
-			 * This call shall not be processed by the thread pool as all the time consuming operations are added
-			 * to the thread pool inside this constructModel() method */
-			std::future<std::unique_ptr<TopoDS_Shape>> ComponentModelFuture = mModifiedComponentModel->constructModel( Parameters );
+			Core::TaskGraph tGraph( Token );
 
-			/* Prepare function pointer to constructModelModifier() method */
-			std::function<std::unique_ptr<TopoDS_Shape>(const std::shared_ptr<Core::ParameterContainer>)> tConstructModelModifierFunction = std::bind( & ComponentModelModifier::constructModelModifier, this, std::placeholders::_1 );
+			/* Take the future of the modified model shape before the graph is run */
+			TModelFuture tModelFuture = this->addModelConstruction( tGraph, Parameters ).getFuture();
 
-			/* Run component model modifier construction in ThreadPool and save the future result - constructed
-			 * component model modifier referenced by shared_ptr to it's interface */
-			std::future<std::unique_ptr<TopoDS_Shape>> ComponentModelModifierFuture = Core::ThreadPool::get_mutable_instance().add( tConstructModelModifierFunction, Parameters );
+			/* Run the construction in ThreadPool and return the future result of it */
+			tGraph.run();
 
-			/* Prepare applyModifier() function pointer to be enqueued in thread pool */
-			std::function<std::unique_ptr<TopoDS_Shape>( const std::shared_ptr<TopoDS_Shape>, const std::shared_ptr<TopoDS_Shape> )> tApplyFunction;
-
-			tApplyFunction = std::bind( & ComponentModelModifier::applyModifier, this, std::placeholders::_1, std::placeholders::_2 );
+			return( tModelFuture );
+		}
 
-			/* Run the applyModifier() method and return the future result of it */
-			return( Core::ThreadPool::get_mutable_instance().add( tApplyFunction, std::move<std::shared_ptr<TopoDS_Shape>>( ComponentModelFuture.get() ), std::move<std::shared_ptr<TopoDS_Shape>>( ComponentModelModifierFuture.get() ) ) );
+		TModelNode addModelConstruction( Core::TaskGraph & Graph, const std::shared_ptr<Core::ParameterContainer> Parameters ) const override final
+		{
+			/* The modified component model adds its own construction jobs first (recursively through the whole
+			 * decorator chain). Its final node provides the component shape to be modified */
+			TModelNode tComponentModelNode = mModifiedComponentModel->addModelConstruction( Graph, Parameters );
+
+			/* Component model modifier construction does not depend on anything so it runs in parallel with
+			 * the component model construction */
+			TModelNode tModelModifierNode = Graph.add( [this, Parameters, Token = Graph.getCancellationToken()]() { return( this->constructModelModifier( Parameters, Token ) ); } );
+
+			/* The modifier is applied once both the shapes are constructed. No job waits for the other ones, the apply
+			 * job is just run after both the predecessors are finished */
+			return( Graph.add(
+				[this, Token = Graph.getCancellationToken()]( std::unique_ptr<TopoDS_Shape> & ComponentShape, std::unique_ptr<TopoDS_Shape> & ModifierShape )
+				{
+					return( this->applyModifier( std::move( ComponentShape ), std::move( ModifierShape ), Token ) );
+				},
+				tComponentModelNode,
+				tModelModifierNode ) );
 		}
 
 	protected:
@@ -11,6 +11,9 @@
 /* Standard library inclusions */
 #include <string>
 
+/* Project specific inclusions */
+#include "Component/BuildStatus.h"
+
 /* Forward declarations */
 class TopoDS_Shape;
 
@@ -25,6 +28,8 @@ namespace Component
 
 		virtual void requestUpdate( void ) = 0;
 
+		virtual BuildStatus getBuildStatus( void ) const = 0;
+
 		virtual ~IComponent( void ) = default;
 
 	protected:
@@ -10,7 +10,11 @@
 
 /* Standard library inclusions */
 #include <memory>
-#include <future>
+
+/* Project specific inclusions */
+#include "ThreadPool/TaskGraph.h"
+#include "ThreadPool/Future.h"
+#include "ThreadPool/Cancellation.h"
 
 /* Forward declarations */
 class TopoDS_Shape;
@@ -25,7 +29,31 @@ namespace Component
 	class IComponentModel
 	{
 	public:
-		virtual std::future<std::unique_ptr<TopoDS_Shape>> constructModel( const std::shared_ptr<Core::ParameterContainer> Parameters ) const = 0;
+		/* Task graph node constructing the model shape */
+		using TModelNode = Core::TaskGraph::Node<std::unique_ptr<TopoDS_Shape>>;
+
+		/* Future model shape. The shape may be processed by a continuation instead of waiting for it */
+		using TModelFuture = Core::Future<std::unique_ptr<TopoDS_Shape>>;
+
+		/**
+		 * @brief Construct model
+		 *
+		 * Starts the model construction in the thread pool. Once the Token is cancelled, the construction jobs not
+		 * started yet are not run and the future fails with Core::Exception::OperationCancelled.
+		 *
+		 * @returns Future model shape
+		 */
+		virtual TModelFuture constructModel( const std::shared_ptr<Core::ParameterContainer> Parameters, const Core::CancellationToken & Token ) const = 0;
+
+		/**
+		 * @brief Add model construction to task graph
+		 *
+		 * Adds all the jobs needed to construct the model shape to the Graph, including their dependencies. The jobs
+		 * are cancelled by the token of the Graph.
+		 *
+		 * @returns Node constructing the final model shape
+		 */
+		virtual TModelNode addModelConstruction( Core::TaskGraph & Graph, const std::shared_ptr<Core::ParameterContainer> Parameters ) const = 0;
 
 		virtual ~IComponentModel( void ) = default;
 
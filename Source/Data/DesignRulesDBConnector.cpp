@@ -7,15 +7,19 @@
 
 /* Standard library inclusions */
 #include <sstream>
+#include <mutex>
 
 /* Boost inclusions */
 #include <boost/filesystem.hpp>
 
 /* Project specific inclusions */
 #include "DesignRulesDBConnector.h"
+#include "ThreadPool/Exception.h"
 
 using namespace Core;
 
+const char * const DesignRulesDBConnector::QueryPoolName = "DesignRulesDB";
+
 DesignRulesDBConnector::DesignRulesDBConnector( void )
 	: 	/* Initially, let's make the connection invalid */
 		mIsConnected( false )
@@ -56,3 +60,21 @@ bool DesignRulesDBConnector::isConnected( void )
 {
 	return( mIsConnected );
 }
+
+Core::ThreadPool & DesignRulesDBConnector::getQueryPool( void )
+{
+	static std::mutex tPoolMutex;
+
+	std::lock_guard<std::mutex> tLock( tPoolMutex );
+
+	/* The pool is not started until needed, most of the runs do not query the database at all. Once destroyed
+	 * by ThreadPool::destroy(), it is created again */
+	try
+	{
+		return( Core::ThreadPool::instance( QueryPoolName ) );
+	}
+	catch( const Core::Exception::InvalidThreadPoolOperation & )
+	{
+		return( Core::ThreadPool::create( QueryPoolName, 1 ) );
+	}
+}
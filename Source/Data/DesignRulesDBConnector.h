@@ -10,6 +10,9 @@
 
 /* Standard library inclusions */
 #include <memory>
+#include <future>
+#include <type_traits>
+#include <utility>
 
 /* Boost inclusions */
 #include <boost/serialization/singleton.hpp>
@@ -29,6 +32,7 @@
 #endif
 
 #include "Exception/Exception.h"
+#include "ThreadPool/ThreadPool.h"
 
 namespace Core
 {
@@ -75,6 +79,73 @@ namespace Core
 		 */
 		bool isConnected( void );
 
+		/**
+		 * @brief Asynchronous database query
+		 *
+		 * Queries block on the disk I/O, so they are run by a dedicated single worker ThreadPool registered as
+		 * QueryPoolName instead of the default one, where they would hold the workers needed by the model construction.
+		 * Single worker serializes the queries sharing the database connection. The database is used through the
+		 * queries only (see queryAndWait() for the synchronous ones).
+		 *
+		 * The pool destroyed by ThreadPool::destroy() is created again by the next query.
+		 *
+		 * @param [in] Function		Query to be run, called with the database as the only argument
+		 *
+		 * @returns Future of the query result
+		 *
+		 * @throws <DesignRulesDBConnector::Exception::DesignRulesDBNotConnected>	Database is not connected
+		 *
+		 * Example usage:
+		 * @code{.cpp}
+		 *      auto Count = DesignRulesDBConnector::get_mutable_instance().query( []( SQLite::Database & Database )
+		 *      {
+		 *      	return( Database.execAndGet( "SELECT COUNT(*) FROM Rules" ).getInt() );
+		 *      } );
+		 * @endcode
+		 */
+		template<typename FUNCTION>
+		auto query( FUNCTION && Function ) -> std::future<typename std::invoke_result<typename std::decay<FUNCTION>::type &, SQLite::Database &>::type>
+		{
+			std::shared_ptr<SQLite::Database> tDatabase = this->mDesignRulesDB;
+
+			if( !tDatabase )
+			{
+				BOOST_THROW_EXCEPTION( Exception::DesignRulesDBNotConnected() << Core::Exception::Message( "DesignRules DB is not connected." ) );
+			}
+
+			return( this->getQueryPool().add(
+				[tDatabase, tFunction = std::forward<FUNCTION>( Function )]() mutable
+				{
+					return( tFunction( (* tDatabase) ) );
+				} ) );
+		}
+
+		/**
+		 * @brief Synchronous database query
+		 *
+		 * Runs the query the same way as query() does and waits for its result. The query pool worker calling it (i.e.
+		 * another query) runs the pending queries meanwhile, so it does not wait for itself.
+		 *
+		 * @param [in] Function		Query to be run, called with the database as the only argument
+		 *
+		 * @returns The query result
+		 *
+		 * @throws <DesignRulesDBConnector::Exception::DesignRulesDBNotConnected>	Database is not connected
+		 * @throws Exception thrown by the query
+		 */
+		template<typename FUNCTION>
+		auto queryAndWait( FUNCTION && Function ) -> typename std::invoke_result<typename std::decay<FUNCTION>::type &, SQLite::Database &>::type
+		{
+			auto tResult = this->query( std::forward<FUNCTION>( Function ) );
+
+			this->getQueryPool().wait( tResult );
+
+			return( tResult.get() );
+		}
+
+		/* Name of the ThreadPool running the queries */
+		static const char * const QueryPoolName;
+
 		operator SQLite::Database & ( void )
 		{
 			return( (* mDesignRulesDB) );
@@ -99,6 +170,9 @@ namespace Core
 		DesignRulesDBConnector( void );
 
 	private:
+		/* Gets the query ThreadPool, creating it by the first query (or the first one after it was destroyed) */
+		Core::ThreadPool & getQueryPool( void );
+
 		/* Booloean value holding database connection status */
 		bool 								mIsConnected;
 		/* SQLite database filename */
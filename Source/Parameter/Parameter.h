@@ -385,53 +385,57 @@ namespace Core
 		{
 			try
 			{
-				/* Create SQL query to read all parameter values from design rules DB */
-				SQLite::Statement Query( DesignRulesDBConnector::get_mutable_instance(), "SELECT * FROM Parameters WHERE ID = :ConstrainedParameterID LIMIT 1" );
-
-				/* Bind requested parameter identification */
-				/* If Identification tag ID type is convertible to required type... */
-				if( true == std::is_convertible<typename PARAMETER_TAG::TIdentifier, int>::value )
-				{
-					/* Bind the SQL query */
-					Query.bind(":ConstrainedParameterID", static_cast<int>( PARAMETER_TAG::ID::value ) );
-				}
-				else
+				/* The query is run by the DesignRules DB query pool, sharing the database connection with the other queries */
+				DesignRulesDBConnector::get_mutable_instance().queryAndWait( [this]( SQLite::Database & Database )
 				{
-					/* ... else throw an exception */
-					BOOST_THROW_EXCEPTION( typename Exception::InvalidParameterIdentification() << Core::Exception::Message( "Identification tag's ID constant type is not convertible." ) );
-				}
+					/* Create SQL query to read all parameter values from design rules DB */
+					SQLite::Statement Query( Database, "SELECT * FROM Parameters WHERE ID = :ConstrainedParameterID LIMIT 1" );
 
-				/* Process the result */
-				while( Query.executeStep() )
-				{
-					/* TODO: Perform data type check --> Factory to construct type from TData string */
-					/* TODO: Perform quantity type check --> Factory to construct type from TQuantity string*/
-
-					/* Load Default quantity value */
-					mDefault = TQuantity::from_value( static_cast<TData>( Query.getColumn( "DefaultQuantity" ).getDouble() ) );
-					/* Load limits */
-					TQuantity tMin = TQuantity::from_value( static_cast<TData>( Query.getColumn( "MinimumQuantity" ).getDouble() ) );
-					/* Temporary maximum quantity definition */
-					TQuantity tMax;
-					/* If MaximumQuantity is set to test value 'INFINITY'... */
-					if( ( Query.getColumn( "MaximumQuantity" ).isText() ) && ( std::string( Query.getColumn( "MaximumQuantity" ).getText() ) == "INFINITY" ) )
+					/* Bind requested parameter identification */
+					/* If Identification tag ID type is convertible to required type... */
+					if( true == std::is_convertible<typename PARAMETER_TAG::TIdentifier, int>::value )
 					{
-						/* ... and TData has built-in infinity value, set it. Otherwise set the range maximum value */
-						( std::numeric_limits<TData>::has_infinity ) ? tMax = TQuantity::from_value( std::numeric_limits<TData>::infinity() ) : tMax = TQuantity::from_value( std::numeric_limits<TData>::max() );
+						/* Bind the SQL query */
+						Query.bind(":ConstrainedParameterID", static_cast<int>( PARAMETER_TAG::ID::value ) );
 					}
 					else
 					{
-						/* Reqular maximum quantity */
-						tMax = TQuantity::from_value( static_cast<TData>( Query.getColumn( "MaximumQuantity" ).getDouble() ) );
+						/* ... else throw an exception */
+						BOOST_THROW_EXCEPTION( typename Exception::InvalidParameterIdentification() << Core::Exception::Message( "Identification tag's ID constant type is not convertible." ) );
 					}
 
-					/* Set the limits */
-					(this)->setLimits( std::make_pair( tMin, tMax ) );
-					/* Load parameter name */
-					mName = std::string( Query.getColumn( "Name" ).getText() );
-					/* Load parameter name */
-					mSymbol = std::string( Query.getColumn( "Symbol" ).getText() );
-				}
+					/* Process the result */
+					while( Query.executeStep() )
+					{
+						/* TODO: Perform data type check --> Factory to construct type from TData string */
+						/* TODO: Perform quantity type check --> Factory to construct type from TQuantity string*/
+
+						/* Load Default quantity value */
+						mDefault = TQuantity::from_value( static_cast<TData>( Query.getColumn( "DefaultQuantity" ).getDouble() ) );
+						/* Load limits */
+						TQuantity tMin = TQuantity::from_value( static_cast<TData>( Query.getColumn( "MinimumQuantity" ).getDouble() ) );
+						/* Temporary maximum quantity definition */
+						TQuantity tMax;
+						/* If MaximumQuantity is set to test value 'INFINITY'... */
+						if( ( Query.getColumn( "MaximumQuantity" ).isText() ) && ( std::string( Query.getColumn( "MaximumQuantity" ).getText() ) == "INFINITY" ) )
+						{
+							/* ... and TData has built-in infinity value, set it. Otherwise set the range maximum value */
+							( std::numeric_limits<TData>::has_infinity ) ? tMax = TQuantity::from_value( std::numeric_limits<TData>::infinity() ) : tMax = TQuantity::from_value( std::numeric_limits<TData>::max() );
+						}
+						else
+						{
+							/* Reqular maximum quantity */
+							tMax = TQuantity::from_value( static_cast<TData>( Query.getColumn( "MaximumQuantity" ).getDouble() ) );
+						}
+
+						/* Set the limits */
+						(this)->setLimits( std::make_pair( tMin, tMax ) );
+						/* Load parameter name */
+						mName = std::string( Query.getColumn( "Name" ).getText() );
+						/* Load parameter name */
+						mSymbol = std::string( Query.getColumn( "Symbol" ).getText() );
+					}
+				} );
 			}
 			/* Something went wrong during data loading from DB */
 			catch( const SQLite::Exception & Exception )
@@ -0,0 +1,374 @@
+/*
+ * ParameterCollection.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_PARAMETER_PARAMETERCOLLECTION_H_
+#define CORE_PARAMETER_PARAMETERCOLLECTION_H_
+
+/* Standard library inclusions */
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/* Project specific inclusions */
+#include "Parameter/IParameter.h"
+#include "Parameter/IParameterTagCollection.h"
+
+namespace Core
+{
+	namespace Detail
+	{
+		/**
+		 * @brief Flat parameter storage
+		 *
+		 * Parameters are kept in single vector sorted by the identifier, so they are iterated in the same order as
+		 * from std::map, but the slots are contiguous and the lookup does not walk any tree. The parameters themselves
+		 * are still allocated one by one, every slot holds the shared pointer to its parameter, so touching the value
+		 * of the parameter found costs another indirection.
+		 *
+		 * The parameter tag identifiers are compile-time constants, so every tag may keep the slot its parameter was
+		 * found in last time (see find()). Containers of the same component share the same layout, so the slot is
+		 * usually right and the lookup costs single comparison. Binary search is the fallback.
+		 *
+		 * The slots are shared with the snapshots (see snapshot()) and copied on the first write after the snapshot was
+		 * taken, so the snapshot stays unchanged and may be iterated without any lock.
+		 *
+		 * Every slot keeps the tag of the type the parameter was stored as (see getTypeTag()), so the parameter may be
+		 * cast back to it without the RTTI.
+		 *
+		 * Insertion invalidates the iterators of the collection, not the ones of its snapshots.
+		 */
+		class ParameterCollection
+		{
+		public:
+			using key_type = IParameterTagCollection::IParameterTag::TIdentifier;
+
+			using mapped_type = std::shared_ptr<IParameter>;
+
+			/* Identifies the type the parameter was stored as, nullptr if unknown */
+			using TTypeTag = const void *;
+
+			/**
+			 * @brief Slot of the collection
+			 *
+			 * The parameter paired with its identifier the same way as in std::map, plus the type tag.
+			 */
+			struct value_type
+				:	public std::pair<key_type, mapped_type>
+			{
+				value_type( key_type Key, mapped_type Parameter, TTypeTag TypeTag = nullptr )
+					:	std::pair<key_type, mapped_type>( Key, std::move( Parameter ) ),
+						mTypeTag( TypeTag )
+				{}
+
+				TTypeTag	mTypeTag;
+			};
+
+			/**
+			 * @brief Get the type tag of the PARAMETER type
+			 *
+			 * Unique within single shared library only. The parameters stored by another library have another tag, so
+			 * they are cast using the RTTI (see cast()).
+			 */
+			template<typename PARAMETER>
+			static TTypeTag getTypeTag( void ) noexcept
+			{
+				static const char tTypeTag = 0;
+
+				return( & tTypeTag );
+			}
+
+			/**
+			 * @brief Cast the parameter in the Slot to the PARAMETER type
+			 *
+			 * Once the parameter was stored as PARAMETER, the static cast is used. The dynamic one otherwise.
+			 *
+			 * @returns The parameter, nullptr if it is not PARAMETER
+			 */
+			template<typename PARAMETER>
+			static std::shared_ptr<PARAMETER> cast( const value_type & Slot ) noexcept
+			{
+				if( Slot.mTypeTag == getTypeTag<PARAMETER>() )
+				{
+					return( std::static_pointer_cast<PARAMETER>( Slot.second ) );
+				}
+
+				return( std::dynamic_pointer_cast<PARAMETER>( Slot.second ) );
+			}
+
+		private:
+			using TSlots = std::vector<value_type>;
+
+		public:
+			/* The slots may be shared with the snapshots, so they are never modified through the iterators */
+			using iterator = TSlots::const_iterator;
+			using const_iterator = TSlots::const_iterator;
+			using reverse_iterator = TSlots::const_reverse_iterator;
+			using const_reverse_iterator = TSlots::const_reverse_iterator;
+
+			/**
+			 * @brief Immutable view of the collection
+			 *
+			 * Holds the slots the collection had once the snapshot was taken. Parameters added to the collection later are
+			 * not visible in the snapshot, the parameters themselves are shared.
+			 */
+			class Snapshot
+			{
+			public:
+				using value_type = ParameterCollection::value_type;
+				using iterator = ParameterCollection::const_iterator;
+				using const_iterator = ParameterCollection::const_iterator;
+				using reverse_iterator = ParameterCollection::const_reverse_iterator;
+				using const_reverse_iterator = ParameterCollection::const_reverse_iterator;
+
+				Snapshot( void )
+					:	mSlots( std::make_shared<const TSlots>() )
+				{}
+
+				const_iterator begin( void ) const noexcept { return( this->mSlots->cbegin() ); }
+				const_iterator end( void ) const noexcept { return( this->mSlots->cend() ); }
+				const_iterator cbegin( void ) const noexcept { return( this->mSlots->cbegin() ); }
+				const_iterator cend( void ) const noexcept { return( this->mSlots->cend() ); }
+				const_reverse_iterator rbegin( void ) const noexcept { return( this->mSlots->crbegin() ); }
+				const_reverse_iterator rend( void ) const noexcept { return( this->mSlots->crend() ); }
+				const_reverse_iterator crbegin( void ) const noexcept { return( this->mSlots->crbegin() ); }
+				const_reverse_iterator crend( void ) const noexcept { return( this->mSlots->crend() ); }
+
+				bool empty( void ) const noexcept
+				{
+					return( this->mSlots->empty() );
+				}
+
+				std::size_t size( void ) const noexcept
+				{
+					return( this->mSlots->size() );
+				}
+
+			private:
+				friend class ParameterCollection;
+
+				explicit Snapshot( std::shared_ptr<const TSlots> Slots ) noexcept
+					:	mSlots( std::move( Slots ) )
+				{}
+
+				std::shared_ptr<const TSlots>	mSlots;
+			};
+
+			ParameterCollection( void )
+				:	mSlots( std::make_shared<TSlots>() ),
+					mShared( false )
+			{}
+
+			ParameterCollection( const ParameterCollection & ) = delete;
+
+			ParameterCollection & operator = ( const ParameterCollection & ) = delete;
+
+			const_iterator begin( void ) const noexcept { return( this->mSlots->cbegin() ); }
+			const_iterator end( void ) const noexcept { return( this->mSlots->cend() ); }
+			const_iterator cbegin( void ) const noexcept { return( this->mSlots->cbegin() ); }
+			const_iterator cend( void ) const noexcept { return( this->mSlots->cend() ); }
+			const_reverse_iterator rbegin( void ) const noexcept { return( this->mSlots->crbegin() ); }
+			const_reverse_iterator rend( void ) const noexcept { return( this->mSlots->crend() ); }
+			const_reverse_iterator crbegin( void ) const noexcept { return( this->mSlots->crbegin() ); }
+			const_reverse_iterator crend( void ) const noexcept { return( this->mSlots->crend() ); }
+
+			bool empty( void ) const noexcept
+			{
+				return( this->mSlots->empty() );
+			}
+
+			std::size_t size( void ) const noexcept
+			{
+				return( this->mSlots->size() );
+			}
+
+			/**
+			 * @brief Take the snapshot of the collection
+			 *
+			 * Costs single reference count increment. The following insertion copies the slots.
+			 *
+			 * May be called concurrently with the other const methods, but not with the modifications.
+			 */
+			Snapshot snapshot( void ) const noexcept
+			{
+				this->mShared.store( true, std::memory_order_relaxed );
+
+				return( Snapshot( this->mSlots ) );
+			}
+
+			/**
+			 * @brief Find the parameter
+			 *
+			 * @param [in] Key		Parameter identifier
+			 *
+			 * @returns Iterator to the parameter, end() if not found
+			 */
+			const_iterator find( key_type Key ) const noexcept
+			{
+				const_iterator tSlot = this->lowerBound( * this->mSlots, Key );
+
+				return( ( ( tSlot != this->mSlots->cend() ) && ( tSlot->first == Key ) ) ? tSlot : this->mSlots->cend() );
+			}
+
+			/**
+			 * @brief Find the parameter starting at the slot hint
+			 *
+			 * The hint is checked first. If it is wrong, the parameter is searched for and the hint is updated to its slot.
+			 *
+			 * @param [in] Key			Parameter identifier
+			 * @param [in,out] Hint		Slot the parameter is expected in, shared by all the containers
+			 *
+			 * @returns Iterator to the parameter, end() if not found
+			 */
+			const_iterator find( key_type Key, std::atomic<std::size_t> & Hint ) const noexcept
+			{
+				const TSlots & tSlots = * this->mSlots;
+
+				std::size_t tHint = Hint.load( std::memory_order_relaxed );
+
+				if( ( tHint < tSlots.size() ) && ( tSlots[ tHint ].first == Key ) )
+				{
+					return( tSlots.cbegin() + static_cast<TSlots::difference_type>( tHint ) );
+				}
+
+				const_iterator tSlot = this->find( Key );
+
+				if( tSlot != tSlots.cend() )
+				{
+					Hint.store( static_cast<std::size_t>( tSlot - tSlots.cbegin() ), std::memory_order_relaxed );
+				}
+
+				return( tSlot );
+			}
+
+			/**
+			 * @brief Get the parameter
+			 *
+			 * @throws <std::out_of_range>	Parameter not found
+			 */
+			const mapped_type & at( key_type Key ) const
+			{
+				const_iterator tSlot = this->find( Key );
+
+				if( tSlot == this->mSlots->cend() )
+				{
+					throw std::out_of_range( "Parameter not found in the collection." );
+				}
+
+				return( tSlot->second );
+			}
+
+			/**
+			 * @brief Insert the parameter, replacing the one with the same identifier
+			 */
+			void assign( value_type Value )
+			{
+				TSlots & tSlots = this->getUniqueSlots();
+
+				TSlots::iterator tSlot = this->lowerBound( tSlots, Value.first );
+
+				if( ( tSlot != tSlots.end() ) && ( tSlot->first == Value.first ) )
+				{
+					* tSlot = std::move( Value );
+				}
+				else
+				{
+					tSlots.insert( tSlot, std::move( Value ) );
+				}
+			}
+
+			/**
+			 * @brief Insert the parameter unless there is one with the same identifier
+			 *
+			 * @returns Iterator to the parameter with the identifier and true if inserted
+			 */
+			std::pair<iterator, bool> insert( value_type Value )
+			{
+				const_iterator tFound = this->lowerBound( * this->mSlots, Value.first );
+
+				if( ( tFound != this->mSlots->cend() ) && ( tFound->first == Value.first ) )
+				{
+					return( std::make_pair( tFound, false ) );
+				}
+
+				/* Not found, so the slots are modified. Copy them first if shared */
+				TSlots & tSlots = this->getUniqueSlots();
+
+				return( std::make_pair( iterator( tSlots.insert( this->lowerBound( tSlots, Value.first ), std::move( Value ) ) ), true ) );
+			}
+
+			/**
+			 * @brief Insert the parameters from the sorted range, skipping the ones with the identifier present already
+			 */
+			template<typename ITERATOR>
+			void insert( ITERATOR First, ITERATOR Last )
+			{
+				const TSlots & tOwnSlots = * this->mSlots;
+
+				std::shared_ptr<TSlots> tMerged = std::make_shared<TSlots>();
+
+				tMerged->reserve( tOwnSlots.size() + static_cast<std::size_t>( std::distance( First, Last ) ) );
+
+				/* Both the ranges are sorted, so they are merged in single pass. Own parameters win */
+				const_iterator tOwn = tOwnSlots.cbegin();
+
+				for( ; First != Last; ++First )
+				{
+					while( ( tOwn != tOwnSlots.cend() ) && ( tOwn->first < First->first ) )
+					{
+						tMerged->push_back( * tOwn++ );
+					}
+
+					if( ( tOwn == tOwnSlots.cend() ) || ( First->first < tOwn->first ) )
+					{
+						tMerged->push_back( * First );
+					}
+				}
+
+				std::copy( tOwn, tOwnSlots.cend(), std::back_inserter( * tMerged ) );
+
+				/* The merged slots are new, so the snapshots keep the old ones untouched */
+				this->mSlots = std::move( tMerged );
+
+				this->mShared.store( false, std::memory_order_relaxed );
+			}
+
+		private:
+			/* Get the slots to be modified. Once any snapshot was taken of them, they are copied first. The snapshot might
+			 * have been released already, but use_count() cannot tell whether its last reader is done with the slots */
+			TSlots & getUniqueSlots( void )
+			{
+				if( this->mShared.load( std::memory_order_relaxed ) )
+				{
+					this->mSlots = std::make_shared<TSlots>( * this->mSlots );
+
+					this->mShared.store( false, std::memory_order_relaxed );
+				}
+
+				return( * this->mSlots );
+			}
+
+			template<typename SLOTS>
+			static auto lowerBound( SLOTS & Slots, key_type Key ) noexcept -> decltype( Slots.begin() )
+			{
+				return( std::lower_bound( Slots.begin(), Slots.end(), Key, []( const value_type & Slot, key_type Value ) { return( Slot.first < Value ); } ) );
+			}
+
+			/* Never null. Shared with the snapshots */
+			std::shared_ptr<TSlots>	mSlots;
+
+			/* Snapshot was taken since the slots were copied last time. Set by the readers, so atomic */
+			mutable std::atomic<bool>	mShared;
+		};
+	}
+}
+
+#endif /* CORE_PARAMETER_PARAMETERCOLLECTION_H_ */
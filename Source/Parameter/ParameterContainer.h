@@ -9,15 +9,18 @@
 #define CORE_PARAMETER_PARAMETERCONTAINER_H_
 
 /* Standard library inclusions */
-#include <map>
+#include <atomic>
+#include <cstdint>
 #include <sstream>
 #include <type_traits>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 
 /* Project specific inclusions */
 #include "Parameter/IParameterTagCollection.h"
 #include "Parameter/Parameter.h"
+#include "Parameter/ParameterCollection.h"
 #include "Parameter/Exception.h"
 #include "Equation/Equation.h"
 #include "Data/DesignRulesDBConnector.h"
@@ -43,7 +46,13 @@ namespace Core
 	/**
 	 * @brief Parameter container
 	 *
-	 * Internally parameter container is std::map which can hold any type of data.
+	 * Internally parameter container is flat collection sorted by the parameter identifier (see Detail::ParameterCollection),
+	 * which can hold any type of data. Every parameter tag remembers the slot its parameter was found in, so the repeated
+	 * lookups of the same parameter do not search the collection at all.
+	 *
+	 * Parameters found are memoised per thread (see resolveParameter()), so the repeated get() of the same parameter
+	 * does not walk the chain of the linked containers again until any parameter with the same tag is added, the
+	 * containers are linked or merged or a container linked by another one is destroyed.
 	 *
 	 * ParameterContainer is configurable which KEY type to use - using template
 	 * parameter PARAMETER_TAG_COLLECTION
@@ -59,9 +68,11 @@ namespace Core
 
 	private:
 		/* Define the type of parameter collection */
-		using TParameterCollection = std::map<TParameterContainerKey, std::shared_ptr<IParameter>>;
+		using TParameterCollection = Detail::ParameterCollection;
 
 	public:
+		/* Pair of parameter identifier and the parameter */
+		using value_type = typename TParameterCollection::value_type;
 
 		/**
 		 * @brief Parameter container factory method
@@ -86,170 +97,41 @@ namespace Core
 		}
 
 		/**
-		 * @brief Default ParameterContainer destructor
+		 * @brief ParameterContainer destructor
 		 *
-		 * Generated by compiler
-		 */
-		~ParameterContainer( void ) = default;
-
-		/**
-		 * @brief Bidirectional iterator to parameters stored in container
+		 * The containers linked to this one lose the parameters found here, so the memoised lookups are invalidated. The
+		 * container no other one has linked never gets its parameters memoised for another container, so its destruction
+		 * keeps the memoised lookups.
 		 */
-		using iterator = typename TParameterCollection::iterator;
-		iterator begin( void ) noexcept
+		~ParameterContainer( void )
 		{
-			iterator tIterator;
-
-			/* Thread-safe parameter collection access block */
+			if( this->mLinked.load( std::memory_order_acquire ) )
 			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
-
-				/* Safely get the begin iterator */
-				tIterator = this->mParameterCollection.begin();
-
-				/* The lock guard expires here so the parameter collection gets unlocked */
+				getLinkGeneration().fetch_add( 1, std::memory_order_release );
 			}
-
-			return( tIterator );
-		}
-
-		iterator end( void ) noexcept
-		{
-			iterator tIterator;
-
-			/* Thread-safe parameter collection access block */
-			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
-
-				/* Safely get the end iterator */
-				tIterator = this->mParameterCollection.end();
-
-				/* The lock guard expires here so the parameter collection gets unlocked */
-			}
-
-			return( tIterator );
 		}
 
 		/**
-		 * @brief Bidirectional iterator to constant parameters stored in container
+		 * @brief Consistent view of the parameters stored in container
 		 */
-		using const_iterator = typename TParameterCollection::const_iterator;
-		const_iterator cbegin( void ) noexcept
-		{
-			const_iterator tIterator;
-
-			/* Thread-safe parameter collection access block */
-			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
-
-				/* Safely get the begin const_iterator */
-				tIterator = this->mParameterCollection.cbegin();
-
-				/* The lock guard expires here so the parameter collection gets unlocked */
-			}
-
-			return( tIterator );
-		}
-
-		const_iterator cend( void ) noexcept
-		{
-			const_iterator tIterator;
-
-			/* Thread-safe parameter collection access block */
-			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
-
-				/* Safely get the end const_iterator */
-				tIterator = this->mParameterCollection.cend();
-
-				/* The lock guard expires here so the parameter collection gets unlocked */
-			}
-
-			return( tIterator );
-		}
+		using Snapshot = typename TParameterCollection::Snapshot;
 
 		/**
-		 * @brief Reverse bidirectional iterator to parameters stored in container
+		 * @brief Take the snapshot of the parameters
+		 *
+		 * The snapshot shares the parameters with the container but is not affected by the parameters added later, so it
+		 * may be iterated without any lock held while other threads add the parameters. Taking the snapshot is cheap, the
+		 * container copies its slots on the next addition instead.
+		 *
+		 * The container itself is iterated through the snapshot only. Its own iterators would be invalidated by any
+		 * parameter added concurrently.
 		 */
-		using reverse_iterator = typename TParameterCollection::reverse_iterator;
-		reverse_iterator rbegin( void ) noexcept
+		Snapshot snapshot( void ) const noexcept
 		{
-			reverse_iterator tIterator;
-
-			/* Thread-safe parameter collection access block */
-			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
-
-				/* Safely get the begin reverse_iterator */
-				tIterator = this->mParameterCollection.rbegin();
+			/* Lock parameter collection for reading, other readers are not blocked */
+			std::shared_lock<std::shared_mutex> lock( this->mParameterCollectionMutex );
 
-				/* The lock guard expires here so the parameter collection gets unlocked */
-			}
-
-			return( tIterator );
-		}
-
-		reverse_iterator rend( void ) noexcept
-		{
-			reverse_iterator tIterator;
-
-			/* Thread-safe parameter collection access block */
-			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
-
-				/* Safely get the end reverse_iterator */
-				tIterator = this->mParameterCollection.rend();
-
-				/* The lock guard expires here so the parameter collection gets unlocked */
-			}
-
-			return( tIterator );
-		}
-
-		/**
-		 * @brief Reverse bidirectional iterator to constant parameters stored in container
-		 */
-		using const_reverse_iterator = typename TParameterCollection::const_reverse_iterator;
-		const_reverse_iterator crbegin( void ) noexcept
-		{
-			const_reverse_iterator tIterator;
-
-			/* Thread-safe parameter collection access block */
-			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
-
-				/* Safely get the begin const_reverse_iterator */
-				tIterator = this->mParameterCollection.crbegin();
-
-				/* The lock guard expires here so the parameter collection gets unlocked */
-			}
-
-			return( tIterator );
-		}
-
-		const_reverse_iterator crend( void ) noexcept
-		{
-			const_reverse_iterator tIterator;
-
-			/* Thread-safe parameter collection access block */
-			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
-
-				/* Safely get the end const_reverse_iterator */
-				tIterator = this->mParameterCollection.crend();
-
-				/* The lock guard expires here so the parameter collection gets unlocked */
-			}
-
-			return( tIterator );
+			return( this->mParameterCollection.snapshot() );
 		}
 
 		/**
@@ -257,14 +139,12 @@ namespace Core
 		 */
 		bool empty( void ) const noexcept
 		{
-			return( mParameterCollection.empty() );
-
 			bool isEmpty = false;
 
 			/* Thread-safe parameter collection access block */
 			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
+				/* Lock parameter collection for reading, other readers are not blocked */
+				std::shared_lock<std::shared_mutex> lock( this->mParameterCollectionMutex );
 
 				/* Safely get the emptiness of parameter collection */
 				isEmpty = this->mParameterCollection.empty();
@@ -284,8 +164,8 @@ namespace Core
 
 			/* Thread-safe parameter collection access block */
 			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
+				/* Lock parameter collection for reading, other readers are not blocked */
+				std::shared_lock<std::shared_mutex> lock( this->mParameterCollectionMutex );
 
 				/* Safely get the size of parameter collection */
 				tSize = this->mParameterCollection.size();
@@ -312,112 +192,90 @@ namespace Core
 			/* Check whether PARAMETER_TAG is compatible with IParameterTag interface */
 			static_assert( std::is_base_of<IParameterTagCollection::IParameterTag, PARAMETER_TAG>::value, "Parameter TAG must be derived from IParameterTag." );
 
-			/* STEP 1 */
-			/* First of all, try to calculate the parameter if it is not available but equation shall be defined (if not, an exception is thrown. */
-#if false
-			try
+			for( ;; )
 			{
-#endif
-				/* If the requested parameter is NOT available anywhere (in this container nor in lined one (works recursively up to the root container in the hierarchy),
-				 * calculate and store it first once the equations are defined (EQUATIONS is not VOID) */
+				const TParameterResolution<typename PARAMETER_TAG::TParameter> & tResolution = this->obtainParameter<PARAMETER_TAG, EQUATIONS>();
 
-				/* If requested parameter is NOT available but threre should be an equation defined to calculate it... */
-				if( ( this->isAvailable<PARAMETER_TAG>() == false ) && ( std::is_same<EQUATIONS, void>::value == false ) )
-				{
-					/* Calculate missing parameter quantity and create the parameter in parameter container */
+				std::shared_ptr<typename PARAMETER_TAG::TParameter> tParameter = tResolution.mParameter.lock();
 
-					/* Run equation and create newly created parameter with calculated quantity into the container */
-					/* @throws <Core::Exception::EquationNotDefined> */
-					this->create<PARAMETER_TAG>( Design::Equation<EQUATIONS, PARAMETER_TAG, void>()( shared_from_this() ) );
+				/* The parameter resolved might have been replaced by another thread meanwhile, it is resolved again then */
+				if( ( tParameter ) || ( tResolution.mRawParameter == nullptr ) )
+				{
+					return( tParameter );
 				}
-#if false
 			}
-			/* Exception thrown by equation execution */
-			catch( const Core::Exception::EquationNotDefined & Exception )
-			{
-				/* Rethrow the exception */
-				/* TODO: Maybe to add some more information to exception */
-				BOOST_THROW_EXCEPTION( Core::Exception::EquationNotDefined() << Core::Exception::Message( Exception.what() ) );
-
-			}
-#endif
-
-			/* Construct temporary parameter of typed defined in PARAMETER_TAG */
-			std::shared_ptr<typename PARAMETER_TAG::TParameter> tParameter;
-
-			/* STEP 2 */
-			/* Try to get the parameter out of this container. It might be calculated in STEP 1 */
-			try
-			{
-				/* Thread-safe parameter collection access block */
+		}
 
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
+		/**
+		 * @brief Get the parameter by reference
+		 *
+		 * Same as get(), but does not touch the parameter's reference count. The reference is valid as long as the parameter
+		 * is held by the container, i.e. until the container is destroyed or the parameter is replaced by create().
+		 *
+		 * @throws <Core::Exception::EquationNotDefined>	Exception is thrown once the equations domain is defined but the equation is not available
+		 * @throws <Core::Exception::ParameterNotFound>		Exception is thrown once the parameter is not found in this container nor in linked one,
+		 * 													or it is not of the type of PARAMETER_TAG (get() returns nullptr then)
+		 */
+		template<typename PARAMETER_TAG, typename EQUATIONS = void>
+		typename PARAMETER_TAG::TParameter & at( void ) noexcept( false )
+		{
+			/* Check whether PARAMETER_TAG is compatible with IParameterTag interface */
+			static_assert( std::is_base_of<IParameterTagCollection::IParameterTag, PARAMETER_TAG>::value, "Parameter TAG must be derived from IParameterTag." );
 
-				/* Safely get the parameter out of the parameter collection */
-				/* @throws <Core::Exception::EquationNotDefined> */
-				tParameter = std::dynamic_pointer_cast<typename PARAMETER_TAG::TParameter>( this->mParameterCollection.at( PARAMETER_TAG::ID::value ) );
+			typename PARAMETER_TAG::TParameter * tParameter = this->obtainParameter<PARAMETER_TAG, EQUATIONS>().mRawParameter;
 
-				/* The lock guard expires here so the parameter collection gets unlocked */
-			}
-			/* Catching 'out of range' exception means the parameter is not available in current container */
-			catch( const std::out_of_range & )
+			if( tParameter == nullptr )
 			{
-				/* STEP 3 */
-				/* Try to get the parameter from linked parameter container */
+				/* Required parameter is stored under the identifier, but it is of another type */
+				std::stringstream Stream;
 
-				/* If there is a valid link to other container... */
-				if( !this->mLinkedContainer.expired() )
-				{
-					/* Once the parameter is requested from linked parameter container, it is under the responsibility of this linked container
-					 * to calculate the parameter. Therefore from this point here, the parameter cannot be calculated (=Equation domain is set to 'void'). */
-					/* @throws <Exception::ParameterNotFound> */
-					tParameter = ( this->mLinkedContainer.lock() )->get<PARAMETER_TAG, void>();
-				}
-				else
-				{
-					/* Parameter was not found within this parameter container and there is no linked one. So there is no container which holds requested parameter */
-					/* Required parameter was not found in the map */
-					std::stringstream Stream;
+				/* Write the message into the string stream */
+				Stream << "Required parameter is of another type: " << getParameterInfo<PARAMETER_TAG>();
 
-					/* Write the message into the string stream */
-					Stream << "Required parameter cannot be found: " << getParameterInfo<PARAMETER_TAG>();
-
-					BOOST_THROW_EXCEPTION( typename Exception::ParameterNotFound() << Core::Exception::Message( Stream.str() ) );
-				}
+				BOOST_THROW_EXCEPTION( typename Exception::ParameterNotFound() << Core::Exception::Message( Stream.str() ) );
 			}
 
-			/* Try to get Parameter of desired type out of storage container */
-			return( tParameter );
+			return( * tParameter );
 		}
 
 		/**
 		 * @brief Adds parameter to parameter storage.
 		 *
-		 * If parameter identified by Key is already existing in std::map, the value of it is overwritten using the Param
-		 * value. If parameter identified is NOT existing, Param is added into std::map.
-		 * Source: www.stackoverflow.com/questions/17172080/insert-vs-emplace-vs-operator-in-c-map
+		 * If parameter identified by Key is already existing in the collection, it is kept and false is returned.
+		 * If parameter identified is NOT existing, Param is added into the collection.
+		 *
+		 * @returns The parameter held by the container under the identifier and true if Parameter was added. The parameter
+		 * 			already existing is cast to the type of PARAMETER_TAG, nullptr if it is of another type
 		 */
 		template<typename PARAMETER_TAG>
-		std::pair<iterator, bool> add( std::shared_ptr<typename PARAMETER_TAG::TParameter> Parameter ) noexcept
+		std::pair<std::shared_ptr<typename PARAMETER_TAG::TParameter>, bool> add( std::shared_ptr<typename PARAMETER_TAG::TParameter> Parameter ) noexcept
 		{
 			/* Check whether PARAMETER_TAG is compatible with IParameterTag interface */
 			static_assert( std::is_base_of<IParameterTagCollection::IParameterTag, PARAMETER_TAG>::value, "Parameter TAG must be derived from IParameterTag." );
 
-			std::pair<iterator, bool> tRetval;
+			std::pair<std::shared_ptr<typename PARAMETER_TAG::TParameter>, bool> tRetval;
 
 			/* Thread-safe parameter collection access block */
 			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
+				/* Lock parameter collection exclusively */
+				std::lock_guard<std::shared_mutex> lock( this->mParameterCollectionMutex );
 
 				/* Safely insert the parameter into the parameter collection */
-				tRetval = this->mParameterCollection.insert( std::pair<TParameterContainerKey, std::shared_ptr<typename PARAMETER_TAG::TParameter>>( PARAMETER_TAG::ID::value, std::move( Parameter ) ) );
+				std::pair<typename TParameterCollection::iterator, bool> tInserted = this->mParameterCollection.insert( value_type( PARAMETER_TAG::ID::value, std::move( Parameter ), TParameterCollection::getTypeTag<typename PARAMETER_TAG::TParameter>() ) );
+
+				/* The iterator is not valid once the lock is released, the parameter is returned instead */
+				tRetval = std::make_pair( TParameterCollection::cast<typename PARAMETER_TAG::TParameter>( * tInserted.first ), tInserted.second );
 
 				/* The lock guard expires here so the parameter collection gets unlocked */
 			}
 
-			/* Return insertion result data - iterator and boolean value of operation status */
+			/* The new parameter may hide the one memoised from the linked container */
+			if( tRetval.second )
+			{
+				getParameterGeneration<PARAMETER_TAG>().fetch_add( 1, std::memory_order_release );
+			}
+
+			/* Return insertion result data - the parameter and boolean value of operation status */
 			return( tRetval );
 		}
 
@@ -454,7 +312,24 @@ namespace Core
 
 		void link( const std::shared_ptr<ParameterContainer> Container ) noexcept
 		{
-			this->mLinkedContainer = Container;
+			/* Thread-safe parameter collection access block */
+			{
+				/* Lock parameter collection exclusively, the link is read together with the parameters */
+				std::lock_guard<std::shared_mutex> lock( this->mParameterCollectionMutex );
+
+				this->mLinkedContainer = Container;
+
+				/* The lock guard expires here so the parameter collection gets unlocked */
+			}
+
+			/* The parameters of the linked container get memoised for this one, its destruction invalidates them */
+			if( Container )
+			{
+				Container->mLinked.store( true, std::memory_order_release );
+			}
+
+			/* Any parameter might have been memoised from the previously linked container */
+			getLinkGeneration().fetch_add( 1, std::memory_order_release );
 		}
 
 		/**
@@ -465,14 +340,23 @@ namespace Core
 		 */
 		void merge( const std::shared_ptr<ParameterContainer> Container ) noexcept
 		{
+			/* Take the consistent view of the other container first, so both are never locked at once (the Container
+			 * may be even this one) */
+			const Snapshot tParameters = Container->snapshot();
+
 			/* Thread-safe parameter collection access block */
-			/* Lock parameter collection */
-			std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
+			{
+				/* Lock parameter collection exclusively */
+				std::lock_guard<std::shared_mutex> lock( this->mParameterCollectionMutex );
 
-			/* Safely insert the parameter into the parameter collection */
-			this->mParameterCollection.insert( Container->begin(), Container->end() );
+				/* Safely insert the parameter into the parameter collection */
+				this->mParameterCollection.insert( tParameters.begin(), tParameters.end() );
 
-			/* The lock guard expires here so the parameter collection gets unlocked */
+				/* The lock guard expires here so the parameter collection gets unlocked */
+			}
+
+			/* The merged parameters may hide the ones memoised from the linked container */
+			getLinkGeneration().fetch_add( 1, std::memory_order_release );
 		}
 
 		/**
@@ -496,11 +380,11 @@ namespace Core
 
 			/* Thread-safe parameter collection access block */
 			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
+				/* Lock parameter collection exclusively */
+				std::lock_guard<std::shared_mutex> lock( this->mParameterCollectionMutex );
 
 				/* Safely insert the parameter into the parameter collection */
-				this->mParameterCollection[ PARAMETER_TAG::ID::value ] = tParam;
+				this->mParameterCollection.assign( value_type( PARAMETER_TAG::ID::value, tParam, TParameterCollection::getTypeTag<typename PARAMETER_TAG::TParameter>() ) );
 
 				/* The lock guard expires here so the parameter collection gets unlocked */
 			}
@@ -508,15 +392,18 @@ namespace Core
 #else
 			/* Thread-safe parameter collection access block */
 			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
+				/* Lock parameter collection exclusively */
+				std::lock_guard<std::shared_mutex> lock( this->mParameterCollectionMutex );
 
 				/* Safely insert the parameter into the parameter collection */
-				this->mParameterCollection[ PARAMETER_TAG::ID::value ] = std::make_shared<typename PARAMETER_TAG::TParameter>( PARAMETER_TAG(), Quantity );
+				this->mParameterCollection.assign( value_type( PARAMETER_TAG::ID::value, std::make_shared<typename PARAMETER_TAG::TParameter>( PARAMETER_TAG(), Quantity ), TParameterCollection::getTypeTag<typename PARAMETER_TAG::TParameter>() ) );
 
 				/* The lock guard expires here so the parameter collection gets unlocked */
 			}
 #endif
+
+			/* The parameter memoised before is replaced or hidden by the new one */
+			getParameterGeneration<PARAMETER_TAG>().fetch_add( 1, std::memory_order_release );
 		}
 
 		/**
@@ -533,45 +420,232 @@ namespace Core
 			/* Check whether PARAMETER_TAG is compatible with IParameterTag interface */
 			static_assert( std::is_base_of<IParameterTagCollection::IParameterTag, PARAMETER_TAG>::value, "Parameter TAG must be derived from IParameterTag." );
 
-			bool tParameterFound = false;
+			/* Search this parameter container and the linked ones. The parameter of another type is available as well */
+			return( this->resolveParameter<PARAMETER_TAG>() != nullptr );
+		}
+
+	private:
+		/**
+		 * @brief Default ParameterContainer constructor
+		 *
+		 * Generated by compiler
+		 */
+		ParameterContainer( void ) noexcept
+			:	mSerialNumber( getNextSerialNumber() )
+		{}
+
+		/**
+		 * @brief ParameterContainer copy constructor
+		 *
+		 * Generated by compiler
+		 */
+		ParameterContainer( const ParameterContainer & ) noexcept = default;
+
+		/**
+		 * @brief Parameter lookup memoised by resolveParameter()
+		 */
+		template<typename PARAMETER>
+		struct TParameterResolution
+		{
+			/* Serial number of the container the parameter was resolved for, 0 if none */
+			std::uint64_t				mContainer = 0;
+
+			/* Generations the resolution is valid for */
+			std::uint64_t				mParameterGeneration = 0;
+			std::uint64_t				mLinkGeneration = 0;
+
+			/* Already cast to the type of the parameter tag, empty if of another type. The memo does not own the parameter,
+			 * so the parameters of the destroyed containers are released */
+			std::weak_ptr<PARAMETER>	mParameter;
+
+			/* The same parameter for at(), valid as long as mParameter has not expired. nullptr if of another type */
+			PARAMETER *					mRawParameter = nullptr;
+		};
+
+		/**
+		 * @brief Get the parameter, calculate it if not available
+		 *
+		 * Implements get() and at(). The returned resolution is memoised for the calling thread by resolveParameter().
+		 * It holds no parameter once the parameter found is not of the type of PARAMETER_TAG, the equation is not run then.
+		 */
+		template<typename PARAMETER_TAG, typename EQUATIONS>
+		const TParameterResolution<typename PARAMETER_TAG::TParameter> & obtainParameter( void ) noexcept( false )
+		{
+			/* STEP 1 */
+			/* Try to find the parameter in this container or in the linked ones (works recursively up to the root container in the hierarchy) */
+			const TParameterResolution<typename PARAMETER_TAG::TParameter> * tFound = this->resolveParameter<PARAMETER_TAG>();
+
+			/* STEP 2 */
+			/* Try to calculate the parameter if it is not available but equation shall be defined (if not, an exception is thrown. */
+#if false
+			try
+			{
+#endif
+				/* If requested parameter is NOT available but threre should be an equation defined to calculate it... */
+				if( ( tFound == nullptr ) && ( std::is_same<EQUATIONS, void>::value == false ) )
+				{
+					/* Calculate missing parameter quantity and create the parameter in parameter container */
+
+					/* Run equation and create newly created parameter with calculated quantity into the container */
+					/* @throws <Core::Exception::EquationNotDefined> */
+					this->create<PARAMETER_TAG>( Design::Equation<EQUATIONS, PARAMETER_TAG, void>()( shared_from_this() ) );
+
+					tFound = this->resolveParameter<PARAMETER_TAG>();
+				}
+#if false
+			}
+			/* Exception thrown by equation execution */
+			catch( const Core::Exception::EquationNotDefined & Exception )
+			{
+				/* Rethrow the exception */
+				/* TODO: Maybe to add some more information to exception */
+				BOOST_THROW_EXCEPTION( Core::Exception::EquationNotDefined() << Core::Exception::Message( Exception.what() ) );
+
+			}
+#endif
+
+			/* STEP 3 */
+			/* Parameter was not found within this parameter container nor in the linked ones. So there is no container which holds requested parameter */
+			if( tFound == nullptr )
+			{
+				/* Required parameter was not found in the collection */
+				std::stringstream Stream;
+
+				/* Write the message into the string stream */
+				Stream << "Required parameter cannot be found: " << getParameterInfo<PARAMETER_TAG>();
+
+				BOOST_THROW_EXCEPTION( typename Exception::ParameterNotFound() << Core::Exception::Message( Stream.str() ) );
+			}
+
+			/* The parameter is already cast to the desired type, none if it is of another one */
+			return( * tFound );
+		}
+
+		/**
+		 * @brief Find the parameter in this container or in the linked ones
+		 *
+		 * The last resolution of each parameter tag is memoised per thread. It is reused as long as this is the same container,
+		 * no parameter with the same tag was added anywhere since, no container was linked or merged, no linked container was
+		 * destroyed and the parameter is still held by some container. Only the parameters found are memoised.
+		 *
+		 * @returns The memoised resolution, valid until the next resolution of PARAMETER_TAG by the calling thread. It holds no
+		 * 			parameter once the parameter is of another type. nullptr if not found
+		 */
+		template<typename PARAMETER_TAG>
+		const TParameterResolution<typename PARAMETER_TAG::TParameter> * resolveParameter( void ) const
+		{
+			thread_local TParameterResolution<typename PARAMETER_TAG::TParameter> tResolution;
+
+			/* The generations must be read before the lookup. Once a parameter is added meanwhile, the resolution gets memoised
+			 * for the old generation, so it is not reused */
+			const std::uint64_t tParameterGeneration = getParameterGeneration<PARAMETER_TAG>().load( std::memory_order_acquire );
+			const std::uint64_t tLinkGeneration = getLinkGeneration().load( std::memory_order_acquire );
+
+			if( ( tResolution.mContainer == this->mSerialNumber ) && ( tResolution.mParameterGeneration == tParameterGeneration ) && ( tResolution.mLinkGeneration == tLinkGeneration )
+				&& ( ( tResolution.mRawParameter == nullptr ) || ( !tResolution.mParameter.expired() ) ) )
+			{
+				return( & tResolution );
+			}
+
+			std::shared_ptr<typename PARAMETER_TAG::TParameter> tParameter;
+
+			if( !this->findParameter<PARAMETER_TAG>( tParameter ) )
+			{
+				return( nullptr );
+			}
+
+			tResolution.mContainer = this->mSerialNumber;
+			tResolution.mParameterGeneration = tParameterGeneration;
+			tResolution.mLinkGeneration = tLinkGeneration;
+			tResolution.mParameter = tParameter;
+			tResolution.mRawParameter = tParameter.get();
+
+			return( & tResolution );
+		}
+
+		/**
+		 * @brief Find the parameter in this container or in the linked ones, not memoised
+		 *
+		 * @param[out] Parameter	The parameter cast to the type of PARAMETER_TAG, nullptr if of another type
+		 *
+		 * @returns true	{Parameter found}
+		 * @returns false	{Parameter was not found within this container nor in the linked ones}
+		 */
+		template<typename PARAMETER_TAG>
+		bool findParameter( std::shared_ptr<typename PARAMETER_TAG::TParameter> & Parameter ) const
+		{
+			std::shared_ptr<ParameterContainer> tLinkedContainer;
 
 			/* Thread-safe parameter collection access block */
 			{
-				/* Lock parameter collection */
-				std::lock_guard<std::mutex> lock( this->mParameterCollectionMutex );
+				/* Lock parameter collection for reading, other readers are not blocked */
+				std::shared_lock<std::shared_mutex> lock( this->mParameterCollectionMutex );
 
-				/* Safely find parameter in collection */
-				/* Once the find() reaches the end of the container, the parameter is not in */
-				tParameterFound = !( this->mParameterCollection.find( PARAMETER_TAG::ID::value ) == this->mParameterCollection.end() );
+				/* Safely find the parameter in the parameter collection, starting at the slot it was found in last time */
+				typename TParameterCollection::const_iterator tSlot = this->mParameterCollection.find( PARAMETER_TAG::ID::value, getParameterSlotHint<PARAMETER_TAG>() );
+
+				if( tSlot != this->mParameterCollection.cend() )
+				{
+					Parameter = TParameterCollection::cast<typename PARAMETER_TAG::TParameter>( * tSlot );
+
+					return( true );
+				}
+
+				tLinkedContainer = this->mLinkedContainer.lock();
 
 				/* The lock guard expires here so the parameter collection gets unlocked */
 			}
 
 			/* If the parameter was NOT found within this parameter container, try to find it in linked one if linked. */
-			if( ( !tParameterFound ) && ( !( this->mLinkedContainer.expired() ) ) )
-			{
-				/* Get the shared pointer to the linked container and ask whether the requested parameter tag is available in here */
-				tParameterFound = ( ( this->mLinkedContainer ).lock() )->isAvailable<PARAMETER_TAG>();
-			}
+			return( tLinkedContainer ? tLinkedContainer->findParameter<PARAMETER_TAG>( Parameter ) : false );
+		}
 
-			/* Return the result */
-			return( tParameterFound );
+		/**
+		 * @brief Get the parameter generation
+		 *
+		 * Incremented once any parameter identified by PARAMETER_TAG is added to any container
+		 */
+		template<typename PARAMETER_TAG>
+		static std::atomic<std::uint64_t> & getParameterGeneration( void ) noexcept
+		{
+			static std::atomic<std::uint64_t> tGeneration( 0 );
+
+			return( tGeneration );
 		}
 
-	private:
 		/**
-		 * @brief Default ParameterContainer constructor
+		 * @brief Get the link generation
 		 *
-		 * Generated by compiler
+		 * Incremented once any containers are linked or merged, or a container linked by another one is destroyed
 		 */
-		ParameterContainer( void ) noexcept = default;
+		static std::atomic<std::uint64_t> & getLinkGeneration( void ) noexcept
+		{
+			static std::atomic<std::uint64_t> tGeneration( 0 );
+
+			return( tGeneration );
+		}
+
+		/* The serial numbers identify the containers in memoised lookups, unlike the addresses they are never reused */
+		static std::uint64_t getNextSerialNumber( void ) noexcept
+		{
+			static std::atomic<std::uint64_t> tSerialNumber( 0 );
+
+			return( tSerialNumber.fetch_add( 1, std::memory_order_relaxed ) + 1 );
+		}
 
 		/**
-		 * @brief ParameterContainer copy constructor
+		 * @brief Get the parameter slot hint
 		 *
-		 * Generated by compiler
+		 * Slot of the collection the parameter identified by PARAMETER_TAG was found in last time. It is shared by all the
+		 * containers, as the containers of the same kind hold the same parameters thus in the same slots.
 		 */
-		ParameterContainer( const ParameterContainer & ) noexcept = default;
+		template<typename PARAMETER_TAG>
+		static std::atomic<std::size_t> & getParameterSlotHint( void ) noexcept
+		{
+			static std::atomic<std::size_t> tSlotHint( 0 );
+
+			return( tSlotHint );
+		}
 
 		/**
 		 * @brief Gather parameter info
@@ -598,19 +672,23 @@ namespace Core
 			{
 				if( DesignRulesDBConnector::get_mutable_instance().isConnected() )
 				{
-					/* Setup the SQL query to read out the names of all the supported design rule options */
-					SQLite::Statement Query( DesignRulesDBConnector::get_mutable_instance(), "SELECT Component,Identification,Name FROM Parameters WHERE ID = :ConstrainedParameterID LIMIT 1" );
-
-					/* Bind requested parameter identification */
-					Query.bind(":ConstrainedParameterID", PARAMETER_TAG::ID::value );
-
-					/* Execute the query */
-					while( Query.executeStep() )
+					/* The query is run by the DesignRules DB query pool, sharing the database connection with the other queries */
+					DesignRulesDBConnector::get_mutable_instance().queryAndWait( [&Stream]( SQLite::Database & Database )
 					{
-						Stream << Query.getColumn( "Component" ).getText() << "::";
-						Stream << Query.getColumn( "Identification" ).getText();
-						Stream << " (" << Query.getColumn( "Name" ).getText() << ")";
-					}
+						/* Setup the SQL query to read out the names of all the supported design rule options */
+						SQLite::Statement Query( Database, "SELECT Component,Identification,Name FROM Parameters WHERE ID = :ConstrainedParameterID LIMIT 1" );
+
+						/* Bind requested parameter identification */
+						Query.bind(":ConstrainedParameterID", PARAMETER_TAG::ID::value );
+
+						/* Execute the query */
+						while( Query.executeStep() )
+						{
+							Stream << Query.getColumn( "Component" ).getText() << "::";
+							Stream << Query.getColumn( "Identification" ).getText();
+							Stream << " (" << Query.getColumn( "Name" ).getText() << ")";
+						}
+					} );
 				}
 				else
 				{
@@ -639,6 +717,12 @@ namespace Core
 			return( Stream.str() );
 		}
 
+		/* Identifies this container in the memoised lookups */
+		const std::uint64_t		mSerialNumber;
+
+		/* Set once another container links this one */
+		std::atomic<bool>		mLinked{ false };
+
 		/* Linked parameter container smart pointer. The pointer is weak as this parameter container does not own
 		 * the linked one so the relation is classified weak */
 		std::weak_ptr<ParameterContainer> mLinkedContainer;
@@ -646,8 +730,10 @@ namespace Core
 		/* Parameter storage */
 		TParameterCollection	mParameterCollection;
 
-		/* The mutex must be made 'mutable' in order to allow it's modification in 'const' functions */
-		mutable std::mutex		mParameterCollectionMutex;
+		/* The mutex must be made 'mutable' in order to allow it's modification in 'const' functions. The parameters are read
+		 * much more often than written (e.g. by the equations running on all the thread pool workers), so the readers share
+		 * the lock and only adding the parameters takes it exclusively */
+		mutable std::shared_mutex	mParameterCollectionMutex;
 	};
 }
 
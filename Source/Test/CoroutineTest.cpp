@@ -0,0 +1,116 @@
+/*
+ * CoroutineTest.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#define BOOST_TEST_MODULE Coroutine
+
+/* Standard library inclusions */
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/* Boost inclusions */
+#include <boost/test/included/unit_test.hpp>
+
+/* Project specific inclusions */
+#include "ThreadPool/Coroutine.h"
+#include "ThreadPool/TaskGraph.h"
+
+/* Built as C++20 only, see CMakeLists.txt */
+#if !defined( CORE_HAS_COROUTINES )
+	#error "Coroutine test requires the compiler supporting coroutines"
+#endif
+
+namespace
+{
+	Core::Async<int> value( int Value )
+	{
+		co_return Value;
+	}
+
+	/* Awaits both the coroutine and the future set by a thread out of the pool */
+	Core::Async<int> sum( int Value )
+	{
+		int tFirst = co_await value( Value );
+
+		Core::Promise<int> tPromise;
+		Core::Future<int> tFuture = tPromise.getFuture();
+
+		std::thread( [Promise = std::move( tPromise ), Value]() mutable
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+
+			Promise.setValue( Value );
+		} ).detach();
+
+		int tSecond = co_await std::move( tFuture );
+
+		co_return tFirst + tSecond;
+	}
+
+	Core::Async<void> failing( void )
+	{
+		co_await Core::resumeIn( Core::ThreadPool::get_mutable_instance() );
+
+		throw std::runtime_error( "failed coroutine" );
+	}
+
+	Core::Async<bool> catching( void )
+	{
+		try
+		{
+			co_await failing();
+		}
+		catch( const std::runtime_error & )
+		{
+			co_return true;
+		}
+
+		co_return false;
+	}
+}
+
+BOOST_AUTO_TEST_CASE( CoroutineAwaitsCoroutinesAndFutures )
+{
+	BOOST_TEST( sum( 4 ).start().get() == 8 );
+
+	std::vector<Core::Future<int>> tResults;
+
+	for( int tIndex = 0; tIndex < 1000; ++tIndex )
+	{
+		tResults.push_back( sum( tIndex ).start() );
+	}
+
+	long tSum = 0;
+
+	for( Core::Future<int> & tResult : tResults )
+	{
+		tSum += tResult.get();
+	}
+
+	BOOST_TEST( tSum == 999L * 1000L );
+}
+
+BOOST_AUTO_TEST_CASE( ExceptionEscapesToAwaitingCoroutine )
+{
+	BOOST_TEST( catching().start().get() );
+	BOOST_CHECK_THROW( failing().start().get(), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( TaskGraphAwaitsCoroutine )
+{
+	Core::TaskGraph tGraph;
+
+	Core::TaskGraph::Node<int> tValue = tGraph.add( []() { return( 2 ); } );
+	Core::TaskGraph::Node<int> tSum = tGraph.addAsync( []( int & Value ) { return( sum( Value ).start() ); }, tValue );
+
+	Core::Future<int> tResult = tGraph.add( []( int & Value ) { return( Value * 10 ); }, tSum ).getFuture();
+
+	tGraph.run();
+
+	BOOST_TEST( tResult.get() == 40 );
+}
@@ -0,0 +1,155 @@
+/*
+ * FutureTest.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#define BOOST_TEST_MODULE Future
+
+/* Standard library inclusions */
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/* Boost inclusions */
+#include <boost/test/included/unit_test.hpp>
+
+/* Project specific inclusions */
+#include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/Future.h"
+#include "ThreadPool/Exception.h"
+
+using Core::Future;
+using Core::Promise;
+
+BOOST_AUTO_TEST_CASE( ContinuationGetsTheResult )
+{
+	Promise<int> tPromise;
+
+	Future<std::string> tFuture = tPromise.getFuture().then( []( Future<int> Result ) { return( std::to_string( Result.get() * 2 ) ); } );
+
+	tPromise.setValue( 21 );
+
+	BOOST_TEST( tFuture.get() == "42" );
+}
+
+BOOST_AUTO_TEST_CASE( ContinuationsChain )
+{
+	Promise<int> tPromise;
+	Future<int> tFuture = tPromise.getFuture();
+
+	for( int tStep = 0; tStep < 100; ++tStep )
+	{
+		tFuture = tFuture.then( []( Future<int> Result ) { return( Result.get() + 1 ); } );
+	}
+
+	tPromise.setValue( 0 );
+
+	BOOST_TEST( tFuture.get() == 100 );
+}
+
+BOOST_AUTO_TEST_CASE( ExceptionPropagatesThroughContinuation )
+{
+	Promise<int> tPromise;
+
+	Future<int> tFuture = tPromise.getFuture().then( []( Future<int> Result ) { return( Result.get() ); } );
+
+	tPromise.setException( std::make_exception_ptr( std::runtime_error( "failed" ) ) );
+
+	BOOST_CHECK_THROW( tFuture.get(), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( AbandonedPromiseBreaksTheFuture )
+{
+	Future<int> tFuture;
+
+	{
+		Promise<int> tPromise;
+
+		tFuture = tPromise.getFuture();
+	}
+
+	BOOST_CHECK_THROW( tFuture.get(), Core::Exception::BrokenPromise );
+	BOOST_CHECK_THROW( Future<int>().get(), Core::Exception::InvalidFutureOperation );
+}
+
+BOOST_AUTO_TEST_CASE( WhenAllWaitsForEveryFuture )
+{
+	std::vector<Promise<int>> tPromises( 5 );
+	std::vector<Future<int>> tFutures;
+
+	for( Promise<int> & tPromise : tPromises )
+	{
+		tFutures.push_back( tPromise.getFuture() );
+	}
+
+	Future<std::vector<Future<int>>> tAll = Core::whenAll( tFutures.begin(), tFutures.end() );
+
+	for( int tIndex = 0; tIndex < 5; ++tIndex )
+	{
+		BOOST_TEST( !tAll.isReady() );
+
+		Core::ThreadPool::get_mutable_instance().add( [&tPromises, tIndex]() { tPromises[ tIndex ].setValue( tIndex ); } );
+	}
+
+	std::vector<Future<int>> tResults = tAll.get();
+	int tSum = 0;
+
+	for( Future<int> & tResult : tResults )
+	{
+		tSum += tResult.get();
+	}
+
+	BOOST_TEST( tSum == 10 );
+}
+
+BOOST_AUTO_TEST_CASE( WhenAllComposesDifferentTypes )
+{
+	Promise<int> tValue;
+	Promise<void> tSignal;
+
+	Future<std::tuple<Future<int>, Future<void>>> tAll = Core::whenAll( tValue.getFuture(), tSignal.getFuture() );
+
+	tSignal.setValue();
+	tValue.setException( std::make_exception_ptr( std::runtime_error( "failed" ) ) );
+
+	std::tuple<Future<int>, Future<void>> tResults = tAll.get();
+
+	BOOST_CHECK_THROW( std::get<0>( tResults ).get(), std::runtime_error );
+	BOOST_CHECK_NO_THROW( std::get<1>( tResults ).get() );
+}
+
+BOOST_AUTO_TEST_CASE( WhenAnyReportsTheFirstReady )
+{
+	std::vector<Promise<int>> tPromises( 3 );
+	std::vector<Future<int>> tFutures;
+
+	for( Promise<int> & tPromise : tPromises )
+	{
+		tFutures.push_back( tPromise.getFuture() );
+	}
+
+	Future<Core::WhenAnyResult<std::vector<Future<int>>>> tAny = Core::whenAny( tFutures.begin(), tFutures.end() );
+
+	tPromises[ 2 ].setValue( 7 );
+
+	Core::WhenAnyResult<std::vector<Future<int>>> tResult = tAny.get();
+
+	BOOST_TEST( tResult.mIndex == 2u );
+	BOOST_TEST( tResult.mFutures[ 2 ].get() == 7 );
+
+	/* The other futures are still bound to their promises */
+	tPromises[ 0 ].setValue( 1 );
+
+	BOOST_TEST( tResult.mFutures[ 0 ].get() == 1 );
+}
+
+BOOST_AUTO_TEST_CASE( EmptyCompositionsAreReady )
+{
+	std::vector<Future<int>> tFutures;
+
+	BOOST_TEST( Core::whenAll( tFutures.begin(), tFutures.end() ).get().empty() );
+	BOOST_TEST( Core::whenAny( tFutures.begin(), tFutures.end() ).get().mIndex == 0u );
+}
@@ -0,0 +1,170 @@
+/*
+ * ParameterContainerTest.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#define BOOST_TEST_MODULE ParameterContainer
+
+/* Standard library inclusions */
+#include <memory>
+#include <thread>
+#include <vector>
+
+/* Boost inclusions */
+#include <boost/test/included/unit_test.hpp>
+
+/* Project specific inclusions */
+#include "Parameter/ParameterContainer.h"
+
+namespace
+{
+	using TLength = Core::Parameter<boost::units::si::length>;
+	using TMass = Core::Parameter<boost::units::si::mass>;
+
+	template<Core::IParameterTagCollection::IParameterTag::TIdentifier IDENTIFIER>
+	struct LengthTag
+		:	public Core::IParameterTagCollection::IParameterTag
+	{
+		using ID = std::integral_constant<TIdentifier, IDENTIFIER>;
+
+		using TParameter = TLength;
+	};
+
+	/* Shares the identifier with LengthTag<1>, but not the type */
+	struct MassTag
+		:	public Core::IParameterTagCollection::IParameterTag
+	{
+		using ID = std::integral_constant<TIdentifier, 1>;
+
+		using TParameter = TMass;
+	};
+
+	std::shared_ptr<TLength> makeLength( double Value )
+	{
+		return( std::make_shared<TLength>( "l", "Length", Value * boost::units::si::meter ) );
+	}
+
+	std::shared_ptr<Core::ParameterContainer> makeContainer( void )
+	{
+		return( Core::ParameterContainer::construct() );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( SnapshotIsNotAffectedByLaterAdditions )
+{
+	std::shared_ptr<Core::ParameterContainer> tContainer = makeContainer();
+
+	tContainer->add<LengthTag<3>>( makeLength( 3.0 ) );
+	tContainer->add<LengthTag<1>>( makeLength( 1.0 ) );
+
+	Core::ParameterContainer::Snapshot tSnapshot = tContainer->snapshot();
+
+	tContainer->add<LengthTag<2>>( makeLength( 2.0 ) );
+
+	BOOST_TEST( tSnapshot.size() == 2u );
+	BOOST_TEST( tContainer->size() == 3u );
+
+	/* Slots are sorted by the identifier */
+	std::vector<int> tIdentifiers;
+
+	for( const Core::ParameterContainer::value_type & tSlot : tContainer->snapshot() )
+	{
+		tIdentifiers.push_back( tSlot.first );
+	}
+
+	BOOST_TEST( tIdentifiers == std::vector<int>( { 1, 2, 3 } ) );
+}
+
+BOOST_AUTO_TEST_CASE( AddKeepsTheExistingParameter )
+{
+	std::shared_ptr<Core::ParameterContainer> tContainer = makeContainer();
+
+	BOOST_TEST( tContainer->add<LengthTag<1>>( makeLength( 1.0 ) ).second );
+
+	std::pair<std::shared_ptr<TLength>, bool> tAdded = tContainer->add<LengthTag<1>>( makeLength( 2.0 ) );
+
+	BOOST_TEST( !tAdded.second );
+	BOOST_TEST( tAdded.first->value() == 1.0 );
+
+	/* The parameter of another type is found, but not cast */
+	BOOST_TEST( tContainer->isAvailable<MassTag>() );
+	BOOST_TEST( !tContainer->get<MassTag>() );
+	BOOST_CHECK_THROW( tContainer->at<MassTag>(), Core::Exception::ParameterNotFound );
+}
+
+BOOST_AUTO_TEST_CASE( MemoisedLookupFollowsTheChanges )
+{
+	std::shared_ptr<Core::ParameterContainer> tRoot = makeContainer();
+	std::shared_ptr<Core::ParameterContainer> tLeaf = makeContainer();
+
+	tRoot->add<LengthTag<1>>( makeLength( 1.0 ) );
+	tLeaf->link( tRoot );
+
+	BOOST_TEST( tLeaf->get<LengthTag<1>>()->value() == 1.0 );
+	BOOST_TEST( tLeaf->at<LengthTag<1>>().value() == 1.0 );
+
+	/* Parameter added to the leaf hides the one memoised from the root */
+	tLeaf->add<LengthTag<1>>( makeLength( 2.0 ) );
+
+	BOOST_TEST( tLeaf->get<LengthTag<1>>()->value() == 2.0 );
+
+	/* Relinked chain is searched again */
+	std::shared_ptr<Core::ParameterContainer> tOtherRoot = makeContainer();
+
+	tRoot->add<LengthTag<2>>( makeLength( 3.0 ) );
+	tOtherRoot->add<LengthTag<2>>( makeLength( 4.0 ) );
+
+	BOOST_TEST( tLeaf->get<LengthTag<2>>()->value() == 3.0 );
+
+	tLeaf->link( tOtherRoot );
+
+	BOOST_TEST( tLeaf->get<LengthTag<2>>()->value() == 4.0 );
+
+	/* Parameter of the destroyed root is not found any more, even if held elsewhere */
+	std::shared_ptr<TLength> tHeld = tLeaf->get<LengthTag<2>>();
+
+	tOtherRoot.reset();
+
+	BOOST_TEST( !tLeaf->isAvailable<LengthTag<2>>() );
+	BOOST_TEST( tHeld->value() == 4.0 );
+}
+
+BOOST_AUTO_TEST_CASE( MemoDoesNotKeepParametersAlive )
+{
+	std::weak_ptr<TLength> tParameter;
+
+	{
+		std::shared_ptr<Core::ParameterContainer> tContainer = makeContainer();
+
+		tContainer->add<LengthTag<5>>( makeLength( 5.0 ) );
+
+		tParameter = tContainer->get<LengthTag<5>>();
+
+		BOOST_TEST( tContainer->at<LengthTag<5>>().value() == 5.0 );
+	}
+
+	BOOST_TEST( tParameter.expired() );
+}
+
+BOOST_AUTO_TEST_CASE( LookupsAreMemoisedPerThread )
+{
+	std::shared_ptr<Core::ParameterContainer> tRoot = makeContainer();
+	std::shared_ptr<Core::ParameterContainer> tLeaf = makeContainer();
+
+	tRoot->add<LengthTag<1>>( makeLength( 1.0 ) );
+	tLeaf->link( tRoot );
+
+	/* The main thread memoises the parameter of the root, the other one sees the leaf's parameter added later */
+	BOOST_TEST( tLeaf->get<LengthTag<1>>()->value() == 1.0 );
+
+	std::thread( [tLeaf]() { tLeaf->add<LengthTag<1>>( makeLength( 2.0 ) ); } ).join();
+
+	double tOtherThread = 0.0;
+
+	std::thread( [tLeaf, &tOtherThread]() { tOtherThread = tLeaf->get<LengthTag<1>>()->value(); } ).join();
+
+	BOOST_TEST( tOtherThread == 2.0 );
+	BOOST_TEST( tLeaf->get<LengthTag<1>>()->value() == 2.0 );
+}
@@ -0,0 +1,139 @@
+/*
+ * TaskGraphTest.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#define BOOST_TEST_MODULE TaskGraph
+
+/* Standard library inclusions */
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+/* Boost inclusions */
+#include <boost/test/included/unit_test.hpp>
+
+/* Project specific inclusions */
+#include "ThreadPool/TaskGraph.h"
+#include "ThreadPool/Exception.h"
+
+using Core::TaskGraph;
+
+BOOST_AUTO_TEST_CASE( ResultsArePassedToSuccessors )
+{
+	TaskGraph tGraph;
+
+	TaskGraph::Node<int> tFirst = tGraph.add( []() { return( 2 ); } );
+	TaskGraph::Node<int> tSecond = tGraph.add( []() { return( 3 ); } );
+	TaskGraph::Node<int> tProduct = tGraph.add( []( int & First, int & Second ) { return( First * Second ); }, tFirst, tSecond );
+
+	Core::Future<std::string> tResult = tGraph.add( []( int & Product ) { return( std::to_string( Product ) ); }, tProduct ).getFuture();
+
+	tGraph.run();
+
+	BOOST_TEST( tResult.get() == "6" );
+}
+
+BOOST_AUTO_TEST_CASE( EverySuccessorGetsItsOwnResult )
+{
+	TaskGraph tGraph;
+
+	TaskGraph::Node<std::string> tSource = tGraph.add( []() { return( std::string( 100, 'x' ) ); } );
+
+	/* Both successors take the result away, neither may see the other one's leftovers */
+	auto tTake = []( std::string & Text ) { std::string tTaken = std::move( Text ); return( tTaken.size() ); };
+
+	Core::Future<std::size_t> tFirst = tGraph.add( tTake, tSource ).getFuture();
+	Core::Future<std::size_t> tSecond = tGraph.add( tTake, tSource ).getFuture();
+
+	tGraph.run();
+
+	BOOST_TEST( tFirst.get() == 100u );
+	BOOST_TEST( tSecond.get() == 100u );
+}
+
+BOOST_AUTO_TEST_CASE( FailurePropagatesToSuccessors )
+{
+	TaskGraph tGraph;
+
+	std::atomic<bool> tSuccessorRun( false );
+
+	TaskGraph::Node<std::string> tFailing = tGraph.add( []() -> std::string { throw std::runtime_error( "failed node" ); } );
+	TaskGraph::Node<std::size_t> tSuccessor = tGraph.add( [&tSuccessorRun]( std::string & Text ) { tSuccessorRun = true; return( Text.size() ); }, tFailing );
+	TaskGraph::Node<void> tDependent = tGraph.add( [&tSuccessorRun]() { tSuccessorRun = true; } );
+
+	tGraph.addDependency( tFailing, tDependent );
+
+	Core::Future<std::size_t> tSize = tGraph.add( []( std::size_t & Size ) { return( Size ); }, tSuccessor ).getFuture();
+	Core::Future<void> tDone = tDependent.getFuture();
+
+	tGraph.run();
+
+	BOOST_CHECK_THROW( tSize.get(), std::runtime_error );
+	BOOST_CHECK_THROW( tDone.get(), std::runtime_error );
+	BOOST_TEST( !tSuccessorRun.load() );
+}
+
+BOOST_AUTO_TEST_CASE( CancelledGraphSkipsRemainingNodes )
+{
+	Core::CancellationSource tSource;
+
+	TaskGraph tGraph( tSource.getToken() );
+
+	std::atomic<bool> tSuccessorRun( false );
+
+	TaskGraph::Node<int> tCancelling = tGraph.add( [&tSource]() { tSource.cancel(); return( 1 ); } );
+
+	Core::Future<int> tResult = tGraph.add( [&tSuccessorRun]( int & Value ) { tSuccessorRun = true; return( Value ); }, tCancelling ).getFuture();
+
+	tGraph.run();
+
+	BOOST_CHECK_THROW( tResult.get(), Core::Exception::OperationCancelled );
+	BOOST_TEST( !tSuccessorRun.load() );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidGraphsAreRejected )
+{
+	TaskGraph tGraph;
+
+	TaskGraph::Node<int> tFirst = tGraph.add( []() { return( 1 ); } );
+	TaskGraph::Node<int> tSecond = tGraph.add( []( int & Value ) { return( Value ); }, tFirst );
+
+	BOOST_CHECK_THROW( tGraph.addDependency( tSecond, tFirst ), Core::Exception::InvalidTaskGraph );
+	BOOST_CHECK_THROW( tGraph.addDependency( tFirst, tFirst ), Core::Exception::InvalidTaskGraph );
+
+	/* Result which cannot be copied has single consumer only */
+	TaskGraph::Node<std::unique_ptr<int>> tUnique = tGraph.add( []() { return( std::make_unique<int>( 3 ) ); } );
+
+	tGraph.add( []( std::unique_ptr<int> & Value ) { return( * Value ); }, tUnique );
+
+	BOOST_CHECK_THROW( tGraph.add( []( std::unique_ptr<int> & Value ) { return( * Value ); }, tUnique ), Core::Exception::InvalidTaskGraph );
+
+	Core::Future<int> tResult = tSecond.getFuture();
+
+	tGraph.run();
+
+	BOOST_TEST( tResult.get() == 1 );
+	BOOST_CHECK_THROW( tGraph.run(), Core::Exception::InvalidTaskGraph );
+}
+
+BOOST_AUTO_TEST_CASE( AsyncNodeFinishesWithItsFuture )
+{
+	TaskGraph tGraph;
+
+	Core::Promise<int> tPromise;
+	Core::Future<int> tOperation = tPromise.getFuture();
+
+	TaskGraph::Node<int> tAsync = tGraph.addAsync( [&tOperation]() { return( std::move( tOperation ) ); } );
+
+	Core::Future<int> tResult = tGraph.add( []( int & Value ) { return( Value * 10 ); }, tAsync ).getFuture();
+
+	tGraph.run();
+
+	tPromise.setValue( 4 );
+
+	BOOST_TEST( tResult.get() == 40 );
+}
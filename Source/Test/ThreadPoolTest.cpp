@@ -0,0 +1,223 @@
+/*
+ * ThreadPoolTest.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#define BOOST_TEST_MODULE ThreadPool
+
+/* Standard library inclusions */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Boost inclusions */
+#include <boost/test/included/unit_test.hpp>
+
+/* Project specific inclusions */
+#include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/Exception.h"
+
+using Core::ThreadPool;
+
+BOOST_AUTO_TEST_CASE( NestedJobsAreStolenByIdleWorkers )
+{
+	ThreadPool tPool( "stealing", 4 );
+
+	/* CORE_THREADPOOL_MODE might have started the pool serial */
+	tPool.setExecutionMode( ThreadPool::ExecutionMode::Parallel );
+
+	std::mutex tMutex;
+	std::set<std::thread::id> tThreads;
+
+	/* All the nested jobs are queued on the worker running the parent one, the others get them by stealing only */
+	tPool.add( [&tPool, &tMutex, &tThreads]()
+	{
+		std::vector<std::future<void>> tJobs;
+
+		for( std::size_t tJob = 0; tJob < 64; ++tJob )
+		{
+			tJobs.push_back( tPool.add( [&tMutex, &tThreads]()
+			{
+				std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+
+				std::lock_guard<std::mutex> tLock( tMutex );
+
+				tThreads.insert( std::this_thread::get_id() );
+			} ) );
+		}
+
+		for( std::future<void> & tJob : tJobs )
+		{
+			tPool.wait( tJob );
+		}
+	} ).get();
+
+	BOOST_TEST( tThreads.size() > 1 );
+}
+
+BOOST_AUTO_TEST_CASE( BackgroundJobIsNotStarvedByInteractiveOnes )
+{
+	ThreadPool tPool( "priorities", 1 );
+
+	tPool.setExecutionMode( ThreadPool::ExecutionMode::Parallel );
+
+	std::atomic<std::size_t> tRun( 0 );
+	std::size_t tBackgroundRunAs = 0;
+
+	tPool.pause( true );
+
+	for( std::size_t tJob = 0; tJob < 200; ++tJob )
+	{
+		tPool.add( ThreadPool::Priority::Interactive, [&tRun]() { ++tRun; } );
+	}
+
+	tPool.add( ThreadPool::Priority::Background, [&tRun, &tBackgroundRunAs]() { tBackgroundRunAs = tRun++; } );
+
+	tPool.pause( false );
+	tPool.wait();
+
+	/* The background lane is served first every 16th job */
+	BOOST_TEST( tRun.load() == 201u );
+	BOOST_TEST( tBackgroundRunAs < 32u );
+}
+
+BOOST_AUTO_TEST_CASE( ShutdownDrainsQueuedJobs )
+{
+	ThreadPool tPool( "drain", 2 );
+
+	std::atomic<std::size_t> tRun( 0 );
+
+	tPool.pause( true );
+
+	for( std::size_t tJob = 0; tJob < 100; ++tJob )
+	{
+		tPool.add( [&tRun]() { ++tRun; } );
+	}
+
+	tPool.pause( false );
+
+	ThreadPool::ShutdownReport tReport = tPool.shutdown( true, std::chrono::seconds( 30 ) );
+
+	BOOST_TEST( tReport.drained );
+	BOOST_TEST( tReport.droppedJobs == 0u );
+	BOOST_TEST( tRun.load() == 100u );
+	BOOST_TEST( tPool.isStopped() );
+
+	BOOST_CHECK_THROW( tPool.add( []() {} ), Core::Exception::InvalidThreadPoolOperation );
+}
+
+BOOST_AUTO_TEST_CASE( ShutdownWithoutDrainDropsQueuedJobs )
+{
+	ThreadPool tPool( "drop", 2 );
+
+	std::vector<std::future<void>> tJobs;
+
+	tPool.pause( true );
+
+	for( std::size_t tJob = 0; tJob < 10; ++tJob )
+	{
+		tJobs.push_back( tPool.add( []() {} ) );
+	}
+
+	ThreadPool::ShutdownReport tReport = tPool.shutdown( false );
+
+	BOOST_TEST( !tReport.drained );
+	BOOST_TEST( tReport.droppedJobs == 10u );
+
+	for( std::future<void> & tJob : tJobs )
+	{
+		BOOST_CHECK_THROW( tJob.get(), std::future_error );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( FailedJobsAreAccounted )
+{
+	ThreadPool tPool( "failures", 2 );
+
+	std::atomic<std::size_t> tHandled( 0 );
+
+	tPool.setFailureHandler( [&tHandled]( const Core::JobFailure & ) { ++tHandled; } );
+
+	std::future<void> tFailed = tPool.add( []() { throw std::runtime_error( "failed job" ); } );
+
+	/* Cancelled jobs are not failures */
+	Core::CancellationSource tSource;
+
+	tSource.cancel();
+
+	std::future<void> tCancelled = tPool.add( tSource.getToken(), []() {} );
+
+	tPool.wait();
+
+	BOOST_CHECK_THROW( tFailed.get(), std::runtime_error );
+	BOOST_CHECK_THROW( tCancelled.get(), Core::Exception::OperationCancelled );
+
+	std::vector<Core::JobFailure> tFailures = tPool.recentFailures();
+
+	BOOST_TEST_REQUIRE( tFailures.size() == 1u );
+	BOOST_TEST( tFailures.front().mMessage == "failed job" );
+	BOOST_TEST( tHandled.load() == 1u );
+	BOOST_TEST( tPool.statistics().mFailedJobs == 1u );
+	BOOST_TEST( tPool.statistics().mCancelledJobs == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( SerialModeRunsJobsInOrder )
+{
+	ThreadPool tPool( "serial", 4 );
+
+	std::mutex tMutex;
+	std::vector<std::size_t> tOrder;
+
+	auto tRecord = [&tMutex, &tOrder]( std::size_t Job )
+	{
+		std::lock_guard<std::mutex> tLock( tMutex );
+
+		tOrder.push_back( Job );
+	};
+
+	/* Jobs queued in parallel mode run before the ones added once serial, in the order they were added */
+	tPool.pause( true );
+
+	for( std::size_t tJob = 0; tJob < 200; ++tJob )
+	{
+		tPool.add( ThreadPool::Priority( tJob % 3 ), tRecord, tJob );
+	}
+
+	tPool.setExecutionMode( ThreadPool::ExecutionMode::Serial );
+
+	BOOST_TEST( tPool.threadCount() == 1u );
+
+	/* Priorities are ignored in the serial mode */
+	for( std::size_t tJob = 200; tJob < 400; ++tJob )
+	{
+		tPool.add( ThreadPool::Priority( tJob % 3 ), tRecord, tJob );
+	}
+
+	tPool.pause( false );
+	tPool.wait();
+
+	BOOST_TEST_REQUIRE( tOrder.size() == 400u );
+	BOOST_TEST( std::is_sorted( tOrder.begin(), tOrder.end() ) );
+
+	tPool.setExecutionMode( ThreadPool::ExecutionMode::Parallel );
+
+	BOOST_TEST( tPool.threadCount() == 4u );
+}
+
+BOOST_AUTO_TEST_CASE( ParallelReduceKeepsTheOrder )
+{
+	ThreadPool tPool( "reduce", 4 );
+
+	std::string tLetters = tPool.parallelReduce( 0, 26, 3, std::string(), []( int Index ) { return( std::string( 1, static_cast<char>( 'a' + Index ) ) ); }, []( std::string First, std::string Second ) { return( First + Second ); } );
+
+	BOOST_TEST( tLetters == "abcdefghijklmnopqrstuvwxyz" );
+}
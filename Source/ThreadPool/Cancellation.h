@@ -0,0 +1,169 @@
+/*
+ * Cancellation.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_CANCELLATION_H_
+#define CORE_THREADPOOL_CANCELLATION_H_
+
+/* Standard library inclusions */
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/* Project specific inclusions */
+#include "ThreadPool/Exception.h"
+
+namespace Core
+{
+	/**
+	 * @brief Cancellation token
+	 *
+	 * Read-only view of the cancellation flag owned by a CancellationSource. The token is passed along with the
+	 * work to be done, the work checks it regularly and gives up once cancelled. The jobs which did not start yet
+	 * are not run at all.
+	 *
+	 * Default constructed token is never cancelled. Copying the token does not allocate.
+	 */
+	class CancellationToken
+	{
+	public:
+		CancellationToken( void ) noexcept = default;
+
+		/**
+		 * @brief Check the cancellation was requested
+		 */
+		bool isCancelled( void ) const noexcept
+		{
+			return( this->mCancelled && this->mCancelled->load( std::memory_order_acquire ) );
+		}
+
+		/**
+		 * @brief Throw if the cancellation was requested
+		 *
+		 * Convenient way to give up the work from deep inside of it.
+		 *
+		 * @throws <Core::Exception::OperationCancelled>	Cancellation requested
+		 */
+		void throwIfCancelled( void ) const
+		{
+			if( this->isCancelled() )
+			{
+				BOOST_THROW_EXCEPTION( Exception::OperationCancelled() << Exception::Message( "Operation cancelled." ) );
+			}
+		}
+
+		/**
+		 * @brief Get the exception the cancelled work fails with
+		 */
+		static std::exception_ptr getCancelledException( void )
+		{
+			try
+			{
+				BOOST_THROW_EXCEPTION( Exception::OperationCancelled() << Exception::Message( "Operation cancelled." ) );
+			}
+			catch( ... )
+			{
+				return( std::current_exception() );
+			}
+		}
+
+	private:
+		friend class CancellationSource;
+
+		explicit CancellationToken( std::shared_ptr<const std::atomic<bool>> Cancelled ) noexcept
+			:	mCancelled( std::move( Cancelled ) )
+		{}
+
+		std::shared_ptr<const std::atomic<bool>>	mCancelled;
+	};
+
+	/**
+	 * @brief Cancellation source
+	 *
+	 * Owns the cancellation flag and hands out the tokens observing it. Once cancelled, the source stays cancelled,
+	 * a new source has to be created for the new work.
+	 *
+	 * Example usage:
+	 * @code{.cpp}
+	 *      Core::CancellationSource Source;
+	 *
+	 *      Core::ThreadPool::get_mutable_instance().add( Source.getToken(), []() { ... } );
+	 *
+	 *      Source.cancel();
+	 * @endcode
+	 */
+	class CancellationSource
+	{
+	public:
+		CancellationSource( void )
+			:	mCancelled( std::make_shared<std::atomic<bool>>( false ) )
+		{}
+
+		/**
+		 * @brief Get the token observing this source
+		 */
+		CancellationToken getToken( void ) const noexcept
+		{
+			return( CancellationToken( this->mCancelled ) );
+		}
+
+		/**
+		 * @brief Request cancellation of all the work holding the tokens of this source
+		 */
+		void cancel( void ) noexcept
+		{
+			this->mCancelled->store( true, std::memory_order_release );
+		}
+
+		bool isCancelled( void ) const noexcept
+		{
+			return( this->mCancelled->load( std::memory_order_acquire ) );
+		}
+
+	private:
+		std::shared_ptr<std::atomic<bool>>	mCancelled;
+	};
+
+	namespace Detail
+	{
+		/**
+		 * @brief Function call not run once cancelled
+		 *
+		 * Wraps the ThreadPool job function so the job cancelled while queued fails with
+		 * Core::Exception::OperationCancelled instead of being run.
+		 *
+		 * @tparam FUNCTION		Function type
+		 */
+		template<typename FUNCTION>
+		class CancellableCall
+		{
+		public:
+			template<typename FUNCTION_ARGUMENT>
+			CancellableCall( const CancellationToken & Token, FUNCTION_ARGUMENT && Function )
+				:	mToken( Token ),
+					mFunction( std::forward<FUNCTION_ARGUMENT>( Function ) )
+			{}
+
+			template<typename... ARGUMENTS>
+			auto operator () ( ARGUMENTS && ...Arguments ) -> typename std::invoke_result<FUNCTION &, ARGUMENTS && ...>::type
+			{
+				this->mToken.throwIfCancelled();
+
+				return( std::invoke( this->mFunction, std::forward<ARGUMENTS>( Arguments )... ) );
+			}
+
+		private:
+			CancellationToken	mToken;
+
+			FUNCTION			mFunction;
+		};
+	}
+}
+
+#endif /* CORE_THREADPOOL_CANCELLATION_H_ */
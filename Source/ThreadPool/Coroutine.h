@@ -0,0 +1,465 @@
+/*
+ * Coroutine.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_COROUTINE_H_
+#define CORE_THREADPOOL_COROUTINE_H_
+
+/* Coroutines are available only to the C++20 translation units, the rest of the library stays C++17 */
+#if defined( __cpp_impl_coroutine ) && defined( __has_include )
+#if __has_include( <coroutine> )
+
+#define CORE_HAS_COROUTINES 1
+
+/* Standard library inclusions */
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/* Project specific inclusions */
+#include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/Future.h"
+#include "ThreadPool/PoolAllocator.h"
+#include "ThreadPool/Failure.h"
+#include "ThreadPool/Exception.h"
+
+namespace Core
+{
+	template<typename RESULT>
+	class Async;
+
+	namespace Detail
+	{
+		/**
+		 * @brief Coroutine promise part not depending on the result type
+		 *
+		 * The coroutine is either awaited by another coroutine, which is resumed once this one is finished, or it is
+		 * started detached, in which case the result is handed over to Core::Future and the frame destroys itself.
+		 */
+		template<typename RESULT>
+		class AsyncPromiseBase
+		{
+		public:
+			/* Resumes the awaiting coroutine, or publishes the result of the detached one */
+			struct FinalAwaiter
+			{
+				bool await_ready( void ) const noexcept
+				{
+					return( false );
+				}
+
+				template<typename PROMISE>
+				std::coroutine_handle<> await_suspend( std::coroutine_handle<PROMISE> Handle ) noexcept
+				{
+					PROMISE & tPromise = Handle.promise();
+
+					if( tPromise.mContinuation )
+					{
+						return( tPromise.mContinuation );
+					}
+
+					/* Failure is accounted once, by the coroutine nobody awaits */
+					if( tPromise.mException )
+					{
+						reportJobFailure( tPromise.mException );
+					}
+
+					/* Nobody owns the detached frame, it is released right after the result is published */
+					Promise<RESULT> tFuturePromise = std::move( * tPromise.mFuturePromise );
+
+					tPromise.publish( tFuturePromise );
+
+					Handle.destroy();
+
+					return( std::noop_coroutine() );
+				}
+
+				void await_resume( void ) const noexcept
+				{}
+			};
+
+			/* Frames are taken from the block pool, same as the jobs and the future states */
+			static void * operator new( std::size_t Size )
+			{
+				return( BlockPool::allocate( Size ) );
+			}
+
+			static void operator delete( void * Frame, std::size_t Size ) noexcept
+			{
+				BlockPool::deallocate( Frame, Size );
+			}
+
+			/* Coroutine does not run until it is awaited or started */
+			std::suspend_always initial_suspend( void ) const noexcept
+			{
+				return( std::suspend_always() );
+			}
+
+			FinalAwaiter final_suspend( void ) const noexcept
+			{
+				return( FinalAwaiter() );
+			}
+
+			void unhandled_exception( void ) noexcept
+			{
+				this->mException = std::current_exception();
+			}
+
+			/* Coroutine awaiting this one */
+			std::coroutine_handle<>				mContinuation;
+
+			/* Promise of the detached coroutine */
+			std::optional<Promise<RESULT>>		mFuturePromise;
+
+			std::exception_ptr					mException;
+		};
+
+		template<typename RESULT>
+		class AsyncPromise
+			:	public AsyncPromiseBase<RESULT>
+		{
+		public:
+			Async<RESULT> get_return_object( void ) noexcept;
+
+			template<typename VALUE = RESULT>
+			void return_value( VALUE && Value )
+			{
+				this->mValue.emplace( std::forward<VALUE>( Value ) );
+			}
+
+			/* Moves the result out of the finished coroutine or rethrows the exception */
+			RESULT take( void )
+			{
+				if( this->mException )
+				{
+					std::rethrow_exception( this->mException );
+				}
+
+				return( std::move( * this->mValue ) );
+			}
+
+			void publish( Promise<RESULT> & FuturePromise ) noexcept
+			{
+				try
+				{
+					this->mException ? FuturePromise.setException( this->mException ) : FuturePromise.setValue( std::move( * this->mValue ) );
+				}
+				catch( ... )
+				{
+					FuturePromise.setException( std::current_exception() );
+				}
+			}
+
+		private:
+			std::optional<RESULT>	mValue;
+		};
+
+		template<>
+		class AsyncPromise<void>
+			:	public AsyncPromiseBase<void>
+		{
+		public:
+			Async<void> get_return_object( void ) noexcept;
+
+			void return_void( void ) noexcept
+			{}
+
+			void take( void )
+			{
+				if( this->mException )
+				{
+					std::rethrow_exception( this->mException );
+				}
+			}
+
+			void publish( Promise<void> & FuturePromise ) noexcept
+			{
+				this->mException ? FuturePromise.setException( this->mException ) : FuturePromise.setValue();
+			}
+		};
+
+		/* Resumes the coroutine as a job of the pool */
+		inline void resumeIn( ThreadPool & Pool, std::coroutine_handle<> Handle )
+		{
+			Pool.add( [Handle]() { Handle.resume(); } );
+		}
+	}
+
+	/**
+	 * @brief Coroutine running in the thread pool
+	 *
+	 * Return type of the coroutines computing their result asynchronously. Instead of blocking on a future, the
+	 * coroutine co_awaits it, so the worker is free to run other jobs until the result is ready. Any number of
+	 * suspended coroutines share the few pool workers.
+	 *
+	 * The coroutine is lazy, it does not run until it is either co_awaited by another coroutine (it runs right
+	 * away in the awaiting thread then), or started in the thread pool by start(). The exception escaping the
+	 * coroutine is rethrown by co_await, or set to the future of the started coroutine.
+	 *
+	 * Available to the C++20 translation units only, CORE_HAS_COROUTINES is defined then.
+	 *
+	 * Example usage:
+	 * @code{.cpp}
+	 *      Core::Async<double> computeArea( Core::Future<double> Width, Core::Future<double> Height )
+	 *      {
+	 *          double tWidth = co_await std::move( Width );
+	 *          double tHeight = co_await std::move( Height );
+	 *
+	 *          co_return( tWidth * tHeight );
+	 *      }
+	 *
+	 *      Core::Future<double> Area = computeArea( ... ).start();
+	 * @endcode
+	 *
+	 * @tparam RESULT	Result type
+	 */
+	template<typename RESULT>
+	class [[nodiscard]] Async
+	{
+	public:
+		using promise_type = Detail::AsyncPromise<RESULT>;
+
+		Async( Async && Other ) noexcept
+			:	mHandle( std::exchange( Other.mHandle, nullptr ) )
+		{}
+
+		Async & operator = ( Async && Other ) noexcept
+		{
+			if( this != & Other )
+			{
+				this->release();
+
+				this->mHandle = std::exchange( Other.mHandle, nullptr );
+			}
+
+			return( *this );
+		}
+
+		Async( const Async & ) = delete;
+
+		Async & operator = ( const Async & ) = delete;
+
+		/**
+		 * @brief Async destructor
+		 *
+		 * Coroutine which was not started is destroyed without running.
+		 */
+		~Async( void )
+		{
+			this->release();
+		}
+
+		/**
+		 * @brief Start the coroutine in the thread pool
+		 *
+		 * The coroutine is detached, it keeps running once this object is destroyed. It is consumed, the object is
+		 * not valid any more.
+		 *
+		 * @param [in] Pool		Thread pool to start the coroutine in
+		 *
+		 * @returns Future of the coroutine result
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Coroutine already started or awaited
+		 * @throws <Core::Exception::InvalidThreadPoolOperation>	Thread pool is stopped
+		 */
+		Future<RESULT> start( ThreadPool & Pool = ThreadPool::get_mutable_instance() )
+		{
+			this->checkHandle();
+
+			std::coroutine_handle<promise_type> tHandle = std::exchange( this->mHandle, nullptr );
+
+			Promise<RESULT> & tFuturePromise = tHandle.promise().mFuturePromise.emplace( Pool );
+			Future<RESULT> tFuture = tFuturePromise.getFuture();
+
+			try
+			{
+				Detail::resumeIn( Pool, tHandle );
+			}
+			catch( ... )
+			{
+				tHandle.destroy();
+
+				throw;
+			}
+
+			return( tFuture );
+		}
+
+		/**
+		 * @brief Await the result by another coroutine
+		 *
+		 * The coroutine runs right away in the awaiting thread, the awaiting coroutine is resumed once it is finished.
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Coroutine already started or awaited
+		 * @throws Exception escaping the coroutine
+		 */
+		auto operator co_await( void ) &&
+		{
+			struct Awaiter
+			{
+				bool await_ready( void ) const noexcept
+				{
+					return( false );
+				}
+
+				std::coroutine_handle<> await_suspend( std::coroutine_handle<> Awaiting ) noexcept
+				{
+					this->mHandle.promise().mContinuation = Awaiting;
+
+					/* Symmetric transfer, the awaited coroutine runs without growing the stack */
+					return( this->mHandle );
+				}
+
+				RESULT await_resume( void )
+				{
+					return( this->mHandle.promise().take() );
+				}
+
+				std::coroutine_handle<promise_type>	mHandle;
+			};
+
+			this->checkHandle();
+
+			/* The frame is still owned by this object, it is released once the awaiting coroutine goes on */
+			return( Awaiter{ this->mHandle } );
+		}
+
+	private:
+		friend class Detail::AsyncPromise<RESULT>;
+
+		explicit Async( std::coroutine_handle<promise_type> Handle ) noexcept
+			:	mHandle( Handle )
+		{}
+
+		void checkHandle( void ) const
+		{
+			if( ( !this->mHandle ) || this->mHandle.promise().mContinuation )
+			{
+				BOOST_THROW_EXCEPTION( Exception::InvalidFutureOperation() << Exception::Message( "Coroutine can be started or awaited only once." ) );
+			}
+		}
+
+		void release( void ) noexcept
+		{
+			if( this->mHandle )
+			{
+				this->mHandle.destroy();
+				this->mHandle = nullptr;
+			}
+		}
+
+		std::coroutine_handle<promise_type>	mHandle;
+	};
+
+	namespace Detail
+	{
+		template<typename RESULT>
+		Async<RESULT> AsyncPromise<RESULT>::get_return_object( void ) noexcept
+		{
+			return( Async<RESULT>( std::coroutine_handle<AsyncPromise<RESULT>>::from_promise( *this ) ) );
+		}
+
+		inline Async<void> AsyncPromise<void>::get_return_object( void ) noexcept
+		{
+			return( Async<void>( std::coroutine_handle<AsyncPromise<void>>::from_promise( *this ) ) );
+		}
+
+		/**
+		 * @brief Awaiter of the Core::Future
+		 *
+		 * The awaiting coroutine is resumed as a job of the future's thread pool once the result is ready, so the
+		 * thread setting the result is not delayed by it.
+		 */
+		template<typename RESULT>
+		class FutureAwaiter
+		{
+		public:
+			explicit FutureAwaiter( Future<RESULT> && Future )
+				:	mFuture( std::move( Future ) ),
+					mState( FutureAccess::getState( this->mFuture ) )
+			{}
+
+			bool await_ready( void ) const
+			{
+				return( this->mState->isReady() );
+			}
+
+			void await_suspend( std::coroutine_handle<> Awaiting )
+			{
+				/* Run by the thread completing the future. Once the pool is stopped, the coroutine is resumed right away */
+				this->mState->addContinuation( [ State = this->mState, Awaiting ]() { addOrRun( State->mPool, [Awaiting]() { Awaiting.resume(); } ); } );
+			}
+
+			RESULT await_resume( void )
+			{
+				return( this->mFuture.get() );
+			}
+
+		private:
+			Future<RESULT>								mFuture;
+
+			std::shared_ptr<FutureStateBase>			mState;
+		};
+
+		/* Moves the awaiting coroutine to the pool */
+		struct PoolAwaiter
+		{
+			bool await_ready( void ) const noexcept
+			{
+				return( false );
+			}
+
+			void await_suspend( std::coroutine_handle<> Awaiting )
+			{
+				resumeIn( mPool, Awaiting );
+			}
+
+			void await_resume( void ) const noexcept
+			{}
+
+			ThreadPool &	mPool;
+		};
+	}
+
+	/**
+	 * @brief Await the future without blocking
+	 *
+	 * The future is consumed. The awaiting coroutine goes on in the thread pool once the result is ready.
+	 *
+	 * @throws <Core::Exception::InvalidFutureOperation>	Future is not valid
+	 * @throws Exception set by the promise
+	 */
+	template<typename RESULT>
+	Detail::FutureAwaiter<RESULT> operator co_await( Future<RESULT> && Future )
+	{
+		return( Detail::FutureAwaiter<RESULT>( std::move( Future ) ) );
+	}
+
+	/**
+	 * @brief Continue the coroutine as a job of the thread pool
+	 *
+	 * Lets the coroutine running outside the pool (or in another pool) move to the Pool. Also lets the long running
+	 * coroutine give the other jobs of the pool a chance.
+	 *
+	 * Example usage:
+	 * @code{.cpp}
+	 *      co_await Core::resumeIn( Core::ThreadPool::get_mutable_instance() );
+	 * @endcode
+	 */
+	inline Detail::PoolAwaiter resumeIn( ThreadPool & Pool )
+	{
+		return( Detail::PoolAwaiter{ Pool } );
+	}
+}
+
+#endif /* __has_include( <coroutine> ) */
+#endif /* __cpp_impl_coroutine */
+
+#endif /* CORE_THREADPOOL_COROUTINE_H_ */
@@ -0,0 +1,79 @@
+/*
+ * Exception.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_EXCEPTION_H_
+#define CORE_THREADPOOL_EXCEPTION_H_
+
+/* Project specific inclusions */
+#include "Exception/Exception.h"
+
+/* Shared library support */
+#include "Core_Export.h"
+
+/* As Core_Export.h header is generated during build, the required CORE_EXPORT
+ * definition might not exist due to missing header file. In order to prevent
+ * syntax errors cause by undefined CORE_EXPORT, define temporary blank one */
+#ifndef CORE_EXPORT
+	#define CORE_EXPORT
+	#define CORE_NO_EXPORT
+#endif
+
+namespace Core
+{
+	namespace Exception
+	{
+		/**
+		 * @brief Invalid thread count exception
+		 *
+		 * InvalidThreadCount is thrown once the ThreadPool is requested to run no worker
+		 * thread at all or more worker threads than it is able to manage.
+		 */
+		struct CORE_EXPORT InvalidThreadCount : virtual Generic {};
+
+		/**
+		 * @brief Invalid thread pool operation exception
+		 *
+		 * InvalidThreadPoolOperation is thrown once the operation requested would block
+		 * the calling pool worker forever (e.g. pool resize called from a pool worker).
+		 */
+		struct CORE_EXPORT InvalidThreadPoolOperation : virtual Generic {};
+
+		/**
+		 * @brief Invalid task graph exception
+		 *
+		 * InvalidTaskGraph is thrown once the task graph is modified after it was run
+		 * or once a node result is requested to be consumed more than once.
+		 */
+		struct CORE_EXPORT InvalidTaskGraph : virtual Generic {};
+
+		/**
+		 * @brief Invalid future operation exception
+		 *
+		 * InvalidFutureOperation is thrown once the future having no shared state is used
+		 * or once the promise is satisfied or its future is retrieved more than once.
+		 */
+		struct CORE_EXPORT InvalidFutureOperation : virtual Generic {};
+
+		/**
+		 * @brief Broken promise exception
+		 *
+		 * BrokenPromise is stored to the future once its promise is destroyed without
+		 * setting the result.
+		 */
+		struct CORE_EXPORT BrokenPromise : virtual Generic {};
+
+		/**
+		 * @brief Operation cancelled exception
+		 *
+		 * OperationCancelled is thrown by the job giving up its work once its cancellation
+		 * token is cancelled. Jobs cancelled before being run fail with it as well.
+		 */
+		struct CORE_EXPORT OperationCancelled : virtual Generic {};
+	}
+}
+
+#endif /* CORE_THREADPOOL_EXCEPTION_H_ */
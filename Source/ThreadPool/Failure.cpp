@@ -0,0 +1,63 @@
+/*
+ * Failure.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+/* Standard library inclusions */
+#include <typeinfo>
+
+/* Boost inclusions */
+#include <boost/core/demangle.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+/* Project specific inclusions */
+#include "ThreadPool/Failure.h"
+#include "Exception/Exception.h"
+
+using namespace Core;
+
+CORE_EXPORT JobFailure JobFailure::describe( const std::exception_ptr & Exception )
+{
+	JobFailure tFailure;
+
+	tFailure.mTime = std::chrono::system_clock::now();
+	tFailure.mException = Exception;
+
+	try
+	{
+		std::rethrow_exception( Exception );
+	}
+	catch( const boost::exception & tException )
+	{
+		tFailure.mType = boost::core::demangle( typeid( tException ).name() );
+
+		const std::string * tMessage = boost::get_error_info<Core::Exception::Message>( tException );
+		const std::exception * tStandardException = dynamic_cast<const std::exception *>( & tException );
+
+		if( tMessage != nullptr )
+		{
+			tFailure.mMessage = * tMessage;
+		}
+		else if( tStandardException != nullptr )
+		{
+			tFailure.mMessage = tStandardException->what();
+		}
+
+		tFailure.mDiagnosticInformation = boost::current_exception_diagnostic_information();
+	}
+	catch( const std::exception & tException )
+	{
+		tFailure.mType = boost::core::demangle( typeid( tException ).name() );
+		tFailure.mMessage = tException.what();
+		tFailure.mDiagnosticInformation = boost::current_exception_diagnostic_information();
+	}
+	catch( ... )
+	{
+		tFailure.mType = "unknown";
+		tFailure.mDiagnosticInformation = boost::current_exception_diagnostic_information();
+	}
+
+	return( tFailure );
+}
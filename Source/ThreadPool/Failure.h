@@ -0,0 +1,70 @@
+/*
+ * Failure.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_FAILURE_H_
+#define CORE_THREADPOOL_FAILURE_H_
+
+/* Standard library inclusions */
+#include <chrono>
+#include <exception>
+#include <string>
+
+/* Shared library support */
+#include "Core_Export.h"
+
+/* As Core_Export.h header is generated during build, the required CORE_EXPORT
+ * definition might not exist due to missing header file. In order to prevent
+ * syntax errors cause by undefined CORE_EXPORT, define temporary blank one */
+#ifndef CORE_EXPORT
+	#define CORE_EXPORT
+	#define CORE_NO_EXPORT
+#endif
+
+namespace Core
+{
+	/**
+	 * @brief Description of the exception a job failed with
+	 *
+	 * Keeps the exception itself as well, so it may be rethrown and handled by its type.
+	 */
+	struct CORE_EXPORT JobFailure
+	{
+		/**
+		 * @brief Describe the exception
+		 *
+		 * @param [in] Exception	Exception to be described, must not be null
+		 */
+		static JobFailure describe( const std::exception_ptr & Exception );
+
+		/* Dynamic type of the exception, demangled */
+		std::string								mType;
+
+		/* Core::Exception::Message attached to the exception if any, what() otherwise */
+		std::string								mMessage;
+
+		/* boost::diagnostic_information() of the exception, including the throw location of BOOST_THROW_EXCEPTION */
+		std::string								mDiagnosticInformation;
+
+		/* Time the failure was described at */
+		std::chrono::system_clock::time_point	mTime;
+
+		std::exception_ptr						mException;
+	};
+
+	namespace Detail
+	{
+		/**
+		 * @brief Report the exception thrown by a job function
+		 *
+		 * Called by the job wrappers catching the exception into the future. The failure is accounted by the
+		 * ThreadPool running the job, nothing is done if called from outside of any pool.
+		 */
+		CORE_EXPORT void reportJobFailure( const std::exception_ptr & Exception ) noexcept;
+	}
+}
+
+#endif /* CORE_THREADPOOL_FAILURE_H_ */
@@ -0,0 +1,797 @@
+/*
+ * Future.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_FUTURE_H_
+#define CORE_THREADPOOL_FUTURE_H_
+
+/* Standard library inclusions */
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Project specific inclusions */
+#include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/PoolAllocator.h"
+#include "ThreadPool/Task.h"
+#include "ThreadPool/Exception.h"
+
+namespace Core
+{
+	template<typename RESULT>
+	class Future;
+
+	template<typename RESULT>
+	class Promise;
+
+	namespace Detail
+	{
+		/**
+		 * @brief Shared state of the future and the promise
+		 *
+		 * Common part of the shared state not depending on the result type. Keeps the continuations to be run
+		 * once the state becomes ready.
+		 */
+		class FutureStateBase
+		{
+		public:
+			explicit FutureStateBase( ThreadPool & Pool )
+				:	mPool( Pool ),
+					mReady( false ),
+					mSatisfied( false )
+			{}
+
+			FutureStateBase( const FutureStateBase & ) = delete;
+
+			FutureStateBase & operator = ( const FutureStateBase & ) = delete;
+
+			bool isReady( void ) const
+			{
+				return( this->mReady );
+			}
+
+			/* Exception set instead of the result. The state must be ready */
+			const std::exception_ptr & getException( void ) const
+			{
+				return( this->mException );
+			}
+
+			void wait( void ) const
+			{
+				std::unique_lock<std::mutex> tLock( this->mMutex );
+
+				this->mReadyCondition.wait( tLock, [this]() { return( this->mReady.load() ); } );
+			}
+
+			bool waitUntil( std::chrono::steady_clock::time_point Deadline ) const
+			{
+				std::unique_lock<std::mutex> tLock( this->mMutex );
+
+				return( this->mReadyCondition.wait_until( tLock, Deadline, [this]() { return( this->mReady.load() ); } ) );
+			}
+
+			/**
+			 * @brief Add function to be run once the state is ready
+			 *
+			 * The continuation is run by the thread making the state ready, or right away by the calling thread
+			 * if the state is ready already. Continuations are expected to be short, the real work is added to
+			 * the thread pool.
+			 */
+			void addContinuation( Task && Continuation )
+			{
+				{
+					std::lock_guard<std::mutex> tLock( this->mMutex );
+
+					if( !this->mReady )
+					{
+						this->mContinuations.push_back( std::move( Continuation ) );
+
+						return;
+					}
+				}
+
+				Continuation();
+			}
+
+			void setException( std::exception_ptr Exception )
+			{
+				std::unique_lock<std::mutex> tLock( this->mMutex );
+
+				this->checkNotSatisfied();
+
+				this->mException = std::move( Exception );
+
+				this->complete( tLock );
+			}
+
+			/* Fails the state unless it is satisfied already. Used by the promise destroyed without setting the result */
+			void abandon( std::exception_ptr Exception )
+			{
+				std::unique_lock<std::mutex> tLock( this->mMutex );
+
+				if( !this->mSatisfied )
+				{
+					this->mException = std::move( Exception );
+
+					this->complete( tLock );
+				}
+			}
+
+			ThreadPool &				mPool;
+
+		protected:
+			void checkNotSatisfied( void ) const
+			{
+				if( this->mSatisfied )
+				{
+					BOOST_THROW_EXCEPTION( Exception::InvalidFutureOperation() << Exception::Message( "Promise already satisfied." ) );
+				}
+			}
+
+			/* Marks the state ready and runs the continuations. Must be called with the mutex locked */
+			void complete( std::unique_lock<std::mutex> & Lock )
+			{
+				this->mSatisfied = true;
+				this->mReady = true;
+
+				std::vector<Task> tContinuations = std::move( this->mContinuations );
+
+				Lock.unlock();
+
+				this->mReadyCondition.notify_all();
+
+				/* Continuations may hold the last reference to the state, so they are released before leaving */
+				for( Task & tContinuation : tContinuations )
+				{
+					tContinuation();
+					tContinuation = Task();
+				}
+			}
+
+			/* Exception to be rethrown instead of returning the result */
+			std::exception_ptr			mException;
+
+			mutable std::mutex			mMutex;
+
+			mutable std::condition_variable	mReadyCondition;
+
+			std::atomic<bool>			mReady;
+
+			bool						mSatisfied;
+
+			std::vector<Task>			mContinuations;
+		};
+
+		/* Void results are stored as an empty value */
+		struct VoidResult {};
+
+		template<typename RESULT>
+		using FutureValue = typename std::conditional<std::is_void<RESULT>::value, VoidResult, RESULT>::type;
+
+		/**
+		 * @brief Shared state of the future and the promise holding the result
+		 *
+		 * @tparam RESULT	Result type
+		 */
+		template<typename RESULT>
+		class FutureState
+			:	public FutureStateBase
+		{
+		public:
+			explicit FutureState( ThreadPool & Pool )
+				:	FutureStateBase( Pool )
+			{}
+
+			template<typename... ARGUMENTS>
+			void setValue( ARGUMENTS && ...Arguments )
+			{
+				std::unique_lock<std::mutex> tLock( this->mMutex );
+
+				this->checkNotSatisfied();
+
+				this->mValue.emplace( std::forward<ARGUMENTS>( Arguments )... );
+
+				this->complete( tLock );
+			}
+
+			/* Moves the result out of the ready state or rethrows the exception stored */
+			RESULT get( void )
+			{
+				if( this->mException )
+				{
+					std::rethrow_exception( this->mException );
+				}
+
+				return( this->getValue( std::is_void<RESULT>() ) );
+			}
+
+		private:
+			RESULT getValue( std::false_type )
+			{
+				return( std::move( * this->mValue ) );
+			}
+
+			void getValue( std::true_type )
+			{}
+
+			std::optional<FutureValue<RESULT>>	mValue;
+		};
+
+		/* Gives the composition functions access to the shared state without consuming the future */
+		struct FutureAccess
+		{
+			template<typename RESULT>
+			static const std::shared_ptr<FutureState<RESULT>> & getState( const Future<RESULT> & Future )
+			{
+				if( !Future.mState )
+				{
+					BOOST_THROW_EXCEPTION( Exception::InvalidFutureOperation() << Exception::Message( "Future has no shared state." ) );
+				}
+
+				return( Future.mState );
+			}
+		};
+
+		/* Calls the function and sets the promise to its result or to the exception thrown. The Upstream exception
+		 * rethrown by the function was reported as the job failure already, so it is not reported again */
+		template<typename RESULT, typename FUNCTION, typename... ARGUMENTS>
+		void fulfil( Promise<RESULT> & Promise, const std::exception_ptr & Upstream, FUNCTION & Function, ARGUMENTS && ...Arguments );
+
+		/* Adds the Job to the Pool. Called by the continuations run by the thread completing a future, which must not get
+		 * any exception, so the Job is run right away once the pool does not take it */
+		template<typename JOB>
+		void addOrRun( ThreadPool & Pool, const JOB & Job )
+		{
+			try
+			{
+				Pool.add( Job );
+			}
+			catch( ... )
+			{
+				Job();
+			}
+		}
+	}
+
+	/**
+	 * @brief Future result of asynchronous operation
+	 *
+	 * Move-only counterpart of std::future, which is able to run continuations. Instead of waiting for the result,
+	 * the caller may attach the function processing the result with then(), or compose several futures with
+	 * whenAll() and whenAny(). The continuations are run in the thread pool once the result is ready, so nothing
+	 * blocks while the results are composed.
+	 *
+	 * Example usage:
+	 * @code{.cpp}
+	 *      Core::Future<int> Size = Graph.add( ... ).getFuture();
+	 *
+	 *      Core::Future<void> Done = Size.then( []( Core::Future<int> Size ) { std::cout << Size.get() << std::endl; } );
+	 * @endcode
+	 *
+	 * @tparam RESULT	Result type
+	 */
+	template<typename RESULT>
+	class Future
+	{
+	public:
+		Future( void ) noexcept = default;
+
+		Future( Future && ) noexcept = default;
+
+		Future & operator = ( Future && ) noexcept = default;
+
+		Future( const Future & ) = delete;
+
+		Future & operator = ( const Future & ) = delete;
+
+		/**
+		 * @brief Check the future refers to a shared state
+		 *
+		 * The future is no longer valid once its result is taken by get() or once it is consumed by then().
+		 */
+		bool valid( void ) const noexcept
+		{
+			return( this->mState != nullptr );
+		}
+
+		/**
+		 * @brief Check the result is available without blocking
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Future is not valid
+		 */
+		bool isReady( void ) const
+		{
+			return( Detail::FutureAccess::getState( *this )->isReady() );
+		}
+
+		/**
+		 * @brief Block until the result is ready
+		 *
+		 * Pool worker keeps running the queued jobs meanwhile, so a job waiting for the future never parks a worker.
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Future is not valid
+		 */
+		void wait( void ) const
+		{
+			const std::shared_ptr<Detail::FutureState<RESULT>> & tState = Detail::FutureAccess::getState( *this );
+
+			if( !tState->mPool.isWorker() )
+			{
+				tState->wait();
+
+				return;
+			}
+
+			while( !tState->isReady() )
+			{
+				/* Nothing to help with, the awaited job is running somewhere. Check regularly as it may add new jobs */
+				if( !tState->mPool.runPendingJob() )
+				{
+					tState->waitUntil( std::chrono::steady_clock::now() + std::chrono::microseconds( 100 ) );
+				}
+			}
+		}
+
+		/**
+		 * @brief Block until the result is ready or until the timeout expires
+		 *
+		 * Does not help with the queued jobs.
+		 *
+		 * @returns true	{Result is ready}
+		 * @returns false	{Timeout expired}
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Future is not valid
+		 */
+		template<typename REP, typename PERIOD>
+		bool waitFor( const std::chrono::duration<REP, PERIOD> & Timeout ) const
+		{
+			return( Detail::FutureAccess::getState( *this )->waitUntil( std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>( Timeout ) ) );
+		}
+
+		/**
+		 * @brief Wait for the result and take it
+		 *
+		 * The future is not valid any more.
+		 *
+		 * @returns The result set by the promise
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Future is not valid
+		 * @throws Exception set by the promise
+		 */
+		RESULT get( void )
+		{
+			this->wait();
+
+			std::shared_ptr<Detail::FutureState<RESULT>> tState = std::move( this->mState );
+
+			return( tState->get() );
+		}
+
+		/**
+		 * @brief Attach continuation
+		 *
+		 * Once the result is ready, the Function is added to the thread pool. It is called with the ready future,
+		 * so it may handle the exception as well as the result. The future is consumed, it is not valid any more.
+		 *
+		 * @param [in] Function		Function to be called with the ready future
+		 *
+		 * @returns Future of the Function result
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Future is not valid
+		 */
+		template<typename FUNCTION>
+		auto then( FUNCTION && Function ) -> Future<typename std::invoke_result<typename std::decay<FUNCTION>::type &, Future<RESULT> &&>::type>
+		{
+			using TResult = typename std::invoke_result<typename std::decay<FUNCTION>::type &, Future<RESULT> &&>::type;
+
+			Detail::FutureAccess::getState( *this );
+
+			std::shared_ptr<Detail::FutureState<RESULT>> tState = std::move( this->mState );
+
+			Promise<TResult> tPromise( tState->mPool );
+			Future<TResult> tFuture = tPromise.getFuture();
+
+			Detail::FutureState<RESULT> & tStateReference = * tState;
+
+			/* The continuation keeps the state alive until it is run. It just adds the Function to the pool, so the
+			 * thread setting the result is not delayed by it */
+			tStateReference.addContinuation(
+				[ State = std::move( tState ), Promise = std::move( tPromise ), Function = std::forward<FUNCTION>( Function ) ]() mutable
+				{
+					ThreadPool & tPool = State->mPool;
+
+					auto tJob = [ State = std::move( State ), Promise = std::move( Promise ), Function = std::move( Function ) ]() mutable
+					{
+						std::exception_ptr tUpstream = State->getException();
+
+						Detail::fulfil( Promise, tUpstream, Function, Future<RESULT>( std::move( State ) ) );
+					};
+
+					/* The thread completing the future must not get any exception, so the Function is called right away
+					 * once the pool is stopped */
+					if( tPool.isStopped() )
+					{
+						tJob();
+
+						return;
+					}
+
+					try
+					{
+						tPool.add( std::move( tJob ) );
+					}
+					catch( ... )
+					{
+						/* The pool was stopped meanwhile. The job is dropped the same way as the ones left in the
+						 * pool stopped, the promise fails with Core::Exception::BrokenPromise */
+					}
+				} );
+
+			return( tFuture );
+		}
+
+	private:
+		friend class Promise<RESULT>;
+
+		friend struct Detail::FutureAccess;
+
+		explicit Future( std::shared_ptr<Detail::FutureState<RESULT>> State ) noexcept
+			:	mState( std::move( State ) )
+		{}
+
+		std::shared_ptr<Detail::FutureState<RESULT>>	mState;
+	};
+
+	/**
+	 * @brief Promise of the future result
+	 *
+	 * Sets the result of the future. Promise destroyed without setting the result fails the future
+	 * with Core::Exception::BrokenPromise.
+	 *
+	 * @tparam RESULT	Result type
+	 */
+	template<typename RESULT>
+	class Promise
+	{
+	public:
+		/**
+		 * @brief Promise constructor
+		 *
+		 * @param [in] Pool		Thread pool running the continuations of the future
+		 */
+		explicit Promise( ThreadPool & Pool = ThreadPool::get_mutable_instance() )
+			:	mState( std::allocate_shared<Detail::FutureState<RESULT>>( Detail::PoolAllocator<char>(), Pool ) ),
+				mFutureRetrieved( false )
+		{}
+
+		Promise( Promise && Other ) noexcept
+			:	mState( std::move( Other.mState ) ),
+				mFutureRetrieved( Other.mFutureRetrieved )
+		{}
+
+		Promise & operator = ( Promise && Other ) noexcept
+		{
+			if( this != & Other )
+			{
+				this->abandon();
+
+				this->mState = std::move( Other.mState );
+				this->mFutureRetrieved = Other.mFutureRetrieved;
+			}
+
+			return( *this );
+		}
+
+		Promise( const Promise & ) = delete;
+
+		Promise & operator = ( const Promise & ) = delete;
+
+		~Promise( void )
+		{
+			this->abandon();
+		}
+
+		/**
+		 * @brief Get the future of the result
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Future already retrieved
+		 */
+		Future<RESULT> getFuture( void )
+		{
+			if( ( !this->mState ) || this->mFutureRetrieved )
+			{
+				BOOST_THROW_EXCEPTION( Exception::InvalidFutureOperation() << Exception::Message( "Future can be retrieved only once." ) );
+			}
+
+			this->mFutureRetrieved = true;
+
+			return( Future<RESULT>( this->mState ) );
+		}
+
+		/**
+		 * @brief Set the result and run the continuations
+		 *
+		 * @param [in] Arguments	Arguments the result is constructed from (none for void result)
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Result already set
+		 */
+		template<typename... ARGUMENTS>
+		void setValue( ARGUMENTS && ...Arguments )
+		{
+			this->checkState();
+
+			this->mState->setValue( std::forward<ARGUMENTS>( Arguments )... );
+		}
+
+		/**
+		 * @brief Set the exception to be rethrown by the future and run the continuations
+		 *
+		 * @throws <Core::Exception::InvalidFutureOperation>	Result already set
+		 */
+		void setException( std::exception_ptr Exception )
+		{
+			this->checkState();
+
+			this->mState->setException( std::move( Exception ) );
+		}
+
+	private:
+		void checkState( void ) const
+		{
+			if( !this->mState )
+			{
+				BOOST_THROW_EXCEPTION( Exception::InvalidFutureOperation() << Exception::Message( "Promise has no shared state." ) );
+			}
+		}
+
+		void abandon( void ) noexcept
+		{
+			if( this->mState && this->mFutureRetrieved )
+			{
+				try
+				{
+					BOOST_THROW_EXCEPTION( Exception::BrokenPromise() << Exception::Message( "Promise destroyed without setting the result." ) );
+				}
+				catch( ... )
+				{
+					this->mState->abandon( std::current_exception() );
+				}
+			}
+
+			this->mState.reset();
+		}
+
+		std::shared_ptr<Detail::FutureState<RESULT>>	mState;
+
+		bool											mFutureRetrieved;
+	};
+
+	/**
+	 * @brief Result of whenAny()
+	 *
+	 * @tparam SEQUENCE		Sequence of the futures passed to whenAny()
+	 */
+	template<typename SEQUENCE>
+	struct WhenAnyResult
+	{
+		/* Index of the first future being ready */
+		std::size_t		mIndex;
+
+		SEQUENCE		mFutures;
+	};
+
+	namespace Detail
+	{
+		template<typename RESULT, typename FUNCTION, typename... ARGUMENTS>
+		void fulfil( std::false_type, Promise<RESULT> & Promise, FUNCTION & Function, ARGUMENTS && ...Arguments )
+		{
+			Promise.setValue( std::invoke( Function, std::forward<ARGUMENTS>( Arguments )... ) );
+		}
+
+		template<typename RESULT, typename FUNCTION, typename... ARGUMENTS>
+		void fulfil( std::true_type, Promise<RESULT> & Promise, FUNCTION & Function, ARGUMENTS && ...Arguments )
+		{
+			std::invoke( Function, std::forward<ARGUMENTS>( Arguments )... );
+
+			Promise.setValue();
+		}
+
+		template<typename RESULT, typename FUNCTION, typename... ARGUMENTS>
+		void fulfil( Promise<RESULT> & Promise, const std::exception_ptr & Upstream, FUNCTION & Function, ARGUMENTS && ...Arguments )
+		{
+			try
+			{
+				fulfil( std::is_void<RESULT>(), Promise, Function, std::forward<ARGUMENTS>( Arguments )... );
+			}
+			catch( ... )
+			{
+				std::exception_ptr tException = std::current_exception();
+
+				if( tException != Upstream )
+				{
+					reportJobFailure( tException );
+				}
+
+				Promise.setException( std::move( tException ) );
+			}
+		}
+
+		/**
+		 * @brief State shared by the futures composed
+		 *
+		 * Holds the futures until the composed future is ready. Every future being ready decrements the counter,
+		 * the one reaching zero sets the composed result.
+		 */
+		template<typename SEQUENCE>
+		struct FutureComposition
+		{
+			FutureComposition( SEQUENCE && Futures, std::size_t Pending )
+				:	mFutures( std::move( Futures ) ),
+					mPending( Pending )
+			{}
+
+			SEQUENCE					mFutures;
+
+			Promise<SEQUENCE>			mPromise;
+
+			std::atomic<std::size_t>	mPending;
+		};
+
+		template<typename... RESULTS, std::size_t... INDICES>
+		Future<std::tuple<Future<RESULTS>...>> whenAll( std::tuple<Future<RESULTS>...> && Futures, std::index_sequence<INDICES...> )
+		{
+			using TComposition = FutureComposition<std::tuple<Future<RESULTS>...>>;
+
+			/* States are taken before any continuation is added, as the futures are moved away once all of them are ready */
+			std::array<std::shared_ptr<FutureStateBase>, sizeof...( RESULTS )> tStates = { { FutureAccess::getState( std::get<INDICES>( Futures ) )... } };
+
+			/* The extra pending count is released once all the continuations are added */
+			std::shared_ptr<TComposition> tComposition = std::make_shared<TComposition>( std::move( Futures ), sizeof...( RESULTS ) + 1 );
+
+			Future<std::tuple<Future<RESULTS>...>> tFuture = tComposition->mPromise.getFuture();
+
+			auto tContinuation = [tComposition]()
+			{
+				if( --( tComposition->mPending ) == 0 )
+				{
+					tComposition->mPromise.setValue( std::move( tComposition->mFutures ) );
+				}
+			};
+
+			for( std::shared_ptr<FutureStateBase> & tState : tStates )
+			{
+				tState->addContinuation( tContinuation );
+			}
+
+			tContinuation();
+
+			return( tFuture );
+		}
+	}
+
+	/**
+	 * @brief Compose futures to single future being ready once all of them are ready
+	 *
+	 * The futures are moved to the result, so every one of them may be inspected for the result or the exception.
+	 *
+	 * @throws <Core::Exception::InvalidFutureOperation>	Any of the futures is not valid
+	 */
+	template<typename... RESULTS>
+	Future<std::tuple<Future<RESULTS>...>> whenAll( Future<RESULTS> && ...Futures )
+	{
+		return( Detail::whenAll( std::tuple<Future<RESULTS>...>( std::move( Futures )... ), std::index_sequence_for<RESULTS...>() ) );
+	}
+
+	/**
+	 * @brief Compose range of futures to single future being ready once all of them are ready
+	 *
+	 * The futures are moved out of the range to the result, keeping their order.
+	 *
+	 * @throws <Core::Exception::InvalidFutureOperation>	Any of the futures is not valid
+	 */
+	template<typename ITERATOR>
+	auto whenAll( ITERATOR First, ITERATOR Last ) -> Future<std::vector<typename std::iterator_traits<ITERATOR>::value_type>>
+	{
+		using TFutures = std::vector<typename std::iterator_traits<ITERATOR>::value_type>;
+		using TComposition = Detail::FutureComposition<TFutures>;
+
+		TFutures tFutures( std::make_move_iterator( First ), std::make_move_iterator( Last ) );
+		std::vector<std::shared_ptr<Detail::FutureStateBase>> tStates;
+
+		tStates.reserve( tFutures.size() );
+
+		for( const typename TFutures::value_type & tFuture : tFutures )
+		{
+			tStates.push_back( Detail::FutureAccess::getState( tFuture ) );
+		}
+
+		std::shared_ptr<TComposition> tComposition = std::make_shared<TComposition>( std::move( tFutures ), tStates.size() + 1 );
+
+		Future<TFutures> tFuture = tComposition->mPromise.getFuture();
+
+		auto tContinuation = [tComposition]()
+		{
+			if( --( tComposition->mPending ) == 0 )
+			{
+				tComposition->mPromise.setValue( std::move( tComposition->mFutures ) );
+			}
+		};
+
+		for( std::shared_ptr<Detail::FutureStateBase> & tState : tStates )
+		{
+			tState->addContinuation( tContinuation );
+		}
+
+		tContinuation();
+
+		return( tFuture );
+	}
+
+	/**
+	 * @brief Compose range of futures to single future being ready once any of them is ready
+	 *
+	 * The futures are moved out of the range to the result, along with the index of the first one being ready.
+	 * Empty range results in the future being ready right away, having the index equal to the size of the range.
+	 *
+	 * @throws <Core::Exception::InvalidFutureOperation>	Any of the futures is not valid
+	 */
+	template<typename ITERATOR>
+	auto whenAny( ITERATOR First, ITERATOR Last ) -> Future<WhenAnyResult<std::vector<typename std::iterator_traits<ITERATOR>::value_type>>>
+	{
+		using TFutures = std::vector<typename std::iterator_traits<ITERATOR>::value_type>;
+		using TResult = WhenAnyResult<TFutures>;
+		using TComposition = Detail::FutureComposition<TResult>;
+
+		TFutures tFutures( std::make_move_iterator( First ), std::make_move_iterator( Last ) );
+		std::vector<std::shared_ptr<Detail::FutureStateBase>> tStates;
+
+		tStates.reserve( tFutures.size() );
+
+		for( const typename TFutures::value_type & tFuture : tFutures )
+		{
+			tStates.push_back( Detail::FutureAccess::getState( tFuture ) );
+		}
+
+		/* The first future being ready takes the counter down to zero, the others do not touch the result any more */
+		std::shared_ptr<TComposition> tComposition = std::make_shared<TComposition>( TResult{ tStates.size(), std::move( tFutures ) }, 1 );
+
+		Future<TResult> tFuture = tComposition->mPromise.getFuture();
+
+		if( tStates.empty() )
+		{
+			tComposition->mPromise.setValue( std::move( tComposition->mFutures ) );
+		}
+
+		for( std::size_t tIndex = 0; tIndex < tStates.size(); ++tIndex )
+		{
+			tStates[ tIndex ]->addContinuation(
+				[tComposition, tIndex]()
+				{
+					if( tComposition->mPending.exchange( 0 ) == 1 )
+					{
+						tComposition->mFutures.mIndex = tIndex;
+						tComposition->mPromise.setValue( std::move( tComposition->mFutures ) );
+					}
+				} );
+		}
+
+		return( tFuture );
+	}
+}
+
+#endif /* CORE_THREADPOOL_FUTURE_H_ */
@@ -0,0 +1,206 @@
+/*
+ * MpmcQueue.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_MPMCQUEUE_H_
+#define CORE_THREADPOOL_MPMCQUEUE_H_
+
+/* Standard library inclusions */
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Core
+{
+	namespace Detail
+	{
+		/**
+		 * @brief Bounded lock-free multi-producer/multi-consumer queue
+		 *
+		 * Ring buffer of cells, every cell carries a sequence number telling whether it is ready to be written or read
+		 * in the current lap. Producers and consumers claim the cells by incrementing their own position counter, so
+		 * neither side ever takes a lock and the two sides touch the same cache line only when they meet on a cell.
+		 *
+		 * The queue never allocates after construction. Once full, tryPush() fails and the caller has to keep the job
+		 * elsewhere.
+		 *
+		 * @tparam JOB	Default constructible, movable job type
+		 */
+		template<typename JOB>
+		class MpmcQueue
+		{
+		public:
+			/**
+			 * @brief Queue constructor
+			 *
+			 * @param [in] Capacity		Maximal number of jobs, rounded up to the power of two
+			 */
+			explicit MpmcQueue( std::size_t Capacity )
+				:	mCells( std::make_unique<Cell[]>( roundUp( Capacity ) ) ),
+					mMask( roundUp( Capacity ) - 1 ),
+					mEnqueuePosition( 0 ),
+					mDequeuePosition( 0 )
+			{
+				for( std::size_t tCell = 0; tCell <= this->mMask; ++tCell )
+				{
+					this->mCells[ tCell ].mSequence.store( tCell, std::memory_order_relaxed );
+				}
+			}
+
+			MpmcQueue( const MpmcQueue & ) = delete;
+			MpmcQueue & operator = ( const MpmcQueue & ) = delete;
+
+			/**
+			 * @brief Push the job at the back of the queue
+			 *
+			 * @param [in] Job	Job to be enqueued, it is moved from only if pushed
+			 *
+			 * @returns true	{Job was pushed}
+			 * @returns false	{Queue is full}
+			 */
+			bool tryPush( JOB && Job )
+			{
+				std::size_t tPosition = this->mEnqueuePosition.load( std::memory_order_relaxed );
+				Cell * tCell = nullptr;
+
+				while( true )
+				{
+					tCell = & this->mCells[ tPosition & this->mMask ];
+
+					std::intptr_t tDifference = static_cast<std::intptr_t>( tCell->mSequence.load( std::memory_order_acquire ) ) - static_cast<std::intptr_t>( tPosition );
+
+					if( tDifference == 0 )
+					{
+						/* The cell is free in this lap, claim it */
+						if( this->mEnqueuePosition.compare_exchange_weak( tPosition, tPosition + 1, std::memory_order_relaxed ) )
+						{
+							break;
+						}
+					}
+					else if( tDifference < 0 )
+					{
+						/* The cell still holds the job of the previous lap */
+						return( false );
+					}
+					else
+					{
+						/* Another producer claimed the cell meanwhile */
+						tPosition = this->mEnqueuePosition.load( std::memory_order_relaxed );
+					}
+				}
+
+				tCell->mJob = std::move( Job );
+				tCell->mSequence.store( tPosition + 1, std::memory_order_release );
+
+				return( true );
+			}
+
+			/**
+			 * @brief Pop the oldest job
+			 *
+			 * @param [out] Job		Job taken out of the queue
+			 *
+			 * @returns true	{Job was taken}
+			 * @returns false	{Queue is empty}
+			 */
+			bool tryPop( JOB & Job )
+			{
+				std::size_t tPosition = this->mDequeuePosition.load( std::memory_order_relaxed );
+				Cell * tCell = nullptr;
+
+				while( true )
+				{
+					tCell = & this->mCells[ tPosition & this->mMask ];
+
+					std::intptr_t tDifference = static_cast<std::intptr_t>( tCell->mSequence.load( std::memory_order_acquire ) ) - static_cast<std::intptr_t>( tPosition + 1 );
+
+					if( tDifference == 0 )
+					{
+						/* The cell holds the job of this lap, claim it */
+						if( this->mDequeuePosition.compare_exchange_weak( tPosition, tPosition + 1, std::memory_order_relaxed ) )
+						{
+							break;
+						}
+					}
+					else if( tDifference < 0 )
+					{
+						/* The cell was not written yet */
+						return( false );
+					}
+					else
+					{
+						/* Another consumer claimed the cell meanwhile */
+						tPosition = this->mDequeuePosition.load( std::memory_order_relaxed );
+					}
+				}
+
+				Job = std::move( tCell->mJob );
+
+				/* The cell is free for the producers of the next lap */
+				tCell->mSequence.store( tPosition + this->mMask + 1, std::memory_order_release );
+
+				return( true );
+			}
+
+			/**
+			 * @brief Drop all the jobs in the queue
+			 *
+			 * @returns Number of jobs dropped
+			 */
+			std::size_t clear( void )
+			{
+				std::size_t tDropped = 0;
+
+				for( JOB tJob; this->tryPop( tJob ); tJob = JOB() )
+				{
+					++tDropped;
+				}
+
+				return( tDropped );
+			}
+
+			std::size_t capacity( void ) const
+			{
+				return( this->mMask + 1 );
+			}
+
+		private:
+			struct Cell
+			{
+				std::atomic<std::size_t>	mSequence;
+
+				JOB							mJob;
+			};
+
+			static std::size_t roundUp( std::size_t Capacity )
+			{
+				std::size_t tCapacity = 2;
+
+				while( tCapacity < Capacity )
+				{
+					tCapacity <<= 1;
+				}
+
+				return( tCapacity );
+			}
+
+			/* Assumed size of the cache line, the positions are kept apart to avoid false sharing */
+			static constexpr std::size_t CacheLineSize = 64;
+
+			const std::unique_ptr<Cell[]>	mCells;
+
+			const std::size_t				mMask;
+
+			alignas( CacheLineSize ) std::atomic<std::size_t>	mEnqueuePosition;
+
+			alignas( CacheLineSize ) std::atomic<std::size_t>	mDequeuePosition;
+		};
+	}
+}
+
+#endif /* CORE_THREADPOOL_MPMCQUEUE_H_ */
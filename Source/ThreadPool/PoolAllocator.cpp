@@ -0,0 +1,213 @@
+/*
+ * PoolAllocator.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+/* Standard library inclusions */
+#include <array>
+#include <atomic>
+#include <mutex>
+
+/* Project specific inclusions */
+#include "ThreadPool/PoolAllocator.h"
+
+using namespace Core::Detail;
+
+namespace
+{
+	/* Block sizes are rounded up to the multiples of the granularity which keeps the blocks aligned
+	 * for any fundamental type */
+	constexpr std::size_t Granularity = alignof( std::max_align_t );
+
+	/* Number of size classes. Bigger blocks are not pooled */
+	constexpr std::size_t SizeClassCount = 16;
+
+	/* Maximum number of free blocks cached by single thread in single size class */
+	constexpr std::size_t MaxCachedBlocks = 1024;
+
+	struct BlockCache;
+
+	/* Precedes every pooled block, so the block is returned to the cache it was allocated from. Takes whole
+	 * granularity to keep the block aligned */
+	struct alignas( Granularity ) BlockHeader
+	{
+		/* Cache of the allocating thread, nullptr once allocated after the thread's cache was released */
+		BlockCache *	mOwner;
+	};
+
+	struct FreeBlock
+	{
+		FreeBlock * mNext;
+	};
+
+	/* Blocks of single thread. The caches are never destroyed, the cache of the exited thread is taken over by
+	 * the next new thread, so the other threads may return the blocks to it any time */
+	struct BlockCache
+	{
+		/* Used by the owning thread only */
+		std::array<FreeBlock *, SizeClassCount>				mFreeBlocks{};
+		std::array<std::size_t, SizeClassCount>				mFreeBlockCount{};
+
+		/* Blocks released by the other threads, taken over by the owning thread once its own ones run out */
+		std::array<std::atomic<FreeBlock *>, SizeClassCount>	mReturnedBlocks{};
+
+		/* Next cache of the exited threads */
+		BlockCache *										mNextAbandoned = nullptr;
+	};
+
+	/* Caches of the exited threads. Trivially destructible list, so even the threads exiting after
+	 * the static destruction may abandon their caches */
+	std::mutex		AbandonedCachesMutex;
+	BlockCache *	AbandonedCaches = nullptr;
+
+	/* Releases the cache of the thread at its exit */
+	struct CacheOwnership
+	{
+		~CacheOwnership( void );
+	};
+
+	/* Both are trivially destructible, so they are still accessible once the ownership is released at thread exit
+	 * (e.g. shared state released by a destructor of another thread local object) */
+	thread_local BlockCache * CurrentCache = nullptr;
+	thread_local bool CacheReleased = false;
+
+	thread_local CacheOwnership Ownership;
+
+	CacheOwnership::~CacheOwnership( void )
+	{
+		if( CurrentCache != nullptr )
+		{
+			std::lock_guard<std::mutex> tLock( AbandonedCachesMutex );
+
+			CurrentCache->mNextAbandoned = AbandonedCaches;
+			AbandonedCaches = CurrentCache;
+		}
+
+		CurrentCache = nullptr;
+		CacheReleased = true;
+	}
+
+	/* Gets the cache of the calling thread, nullptr once released at thread exit */
+	BlockCache * getCache( void )
+	{
+		if( ( CurrentCache == nullptr ) && ( !CacheReleased ) )
+		{
+			/* Touching the ownership for the first time constructs it, so the cache is released at thread exit */
+			static_cast<void>( & Ownership );
+
+			{
+				std::lock_guard<std::mutex> tLock( AbandonedCachesMutex );
+
+				if( AbandonedCaches != nullptr )
+				{
+					CurrentCache = AbandonedCaches;
+					AbandonedCaches = CurrentCache->mNextAbandoned;
+				}
+			}
+
+			if( CurrentCache == nullptr )
+			{
+				CurrentCache = new BlockCache();
+			}
+		}
+
+		return( CurrentCache );
+	}
+
+	std::size_t getSizeClass( std::size_t Size )
+	{
+		return( ( Size + Granularity - 1 ) / Granularity - 1 );
+	}
+}
+
+CORE_EXPORT void * BlockPool::allocate( std::size_t Size )
+{
+	std::size_t tSizeClass = getSizeClass( Size );
+
+	if( tSizeClass < SizeClassCount )
+	{
+		BlockCache * tCache = getCache();
+
+		if( tCache != nullptr )
+		{
+			FreeBlock * tBlock = tCache->mFreeBlocks[ tSizeClass ];
+
+			/* Own blocks ran out, take over the ones returned by the other threads */
+			if( tBlock == nullptr )
+			{
+				tBlock = tCache->mReturnedBlocks[ tSizeClass ].exchange( nullptr, std::memory_order_acquire );
+
+				for( FreeBlock * tReturned = tBlock; tReturned != nullptr; tReturned = tReturned->mNext )
+				{
+					++tCache->mFreeBlockCount[ tSizeClass ];
+				}
+			}
+
+			if( tBlock != nullptr )
+			{
+				tCache->mFreeBlocks[ tSizeClass ] = tBlock->mNext;
+				--tCache->mFreeBlockCount[ tSizeClass ];
+
+				return( tBlock );
+			}
+		}
+
+		/* Allocate the whole size class so the block can be reused for any size of the class */
+		BlockHeader * tHeader = static_cast<BlockHeader *>( ::operator new( sizeof( BlockHeader ) + ( tSizeClass + 1 ) * Granularity ) );
+
+		tHeader->mOwner = tCache;
+
+		return( tHeader + 1 );
+	}
+
+	return( ::operator new( Size ) );
+}
+
+CORE_EXPORT void BlockPool::deallocate( void * Block, std::size_t Size ) noexcept
+{
+	std::size_t tSizeClass = getSizeClass( Size );
+
+	if( tSizeClass >= SizeClassCount )
+	{
+		::operator delete( Block );
+
+		return;
+	}
+
+	BlockHeader * tHeader = static_cast<BlockHeader *>( Block ) - 1;
+	BlockCache * tOwner = tHeader->mOwner;
+	FreeBlock * tBlock = static_cast<FreeBlock *>( Block );
+
+	if( tOwner == nullptr )
+	{
+		::operator delete( tHeader );
+	}
+	/* Owning thread keeps its cache bounded */
+	else if( tOwner == CurrentCache )
+	{
+		if( tOwner->mFreeBlockCount[ tSizeClass ] < MaxCachedBlocks )
+		{
+			tBlock->mNext = tOwner->mFreeBlocks[ tSizeClass ];
+			tOwner->mFreeBlocks[ tSizeClass ] = tBlock;
+			++tOwner->mFreeBlockCount[ tSizeClass ];
+		}
+		else
+		{
+			::operator delete( tHeader );
+		}
+	}
+	/* Block of another thread is returned to it, so the thread allocating the jobs (e.g. the one submitting
+	 * them from outside of the pool) reuses the blocks released by the workers. The returned blocks are
+	 * bounded by the number of blocks the owner has allocated */
+	else
+	{
+		std::atomic<FreeBlock *> & tReturned = tOwner->mReturnedBlocks[ tSizeClass ];
+
+		tBlock->mNext = tReturned.load( std::memory_order_relaxed );
+
+		while( !tReturned.compare_exchange_weak( tBlock->mNext, tBlock, std::memory_order_release, std::memory_order_relaxed ) )
+		{}
+	}
+}
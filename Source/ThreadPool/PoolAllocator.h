@@ -0,0 +1,111 @@
+/*
+ * PoolAllocator.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_POOLALLOCATOR_H_
+#define CORE_THREADPOOL_POOLALLOCATOR_H_
+
+/* Standard library inclusions */
+#include <cstddef>
+#include <new>
+
+/* Shared library support */
+#include "Core_Export.h"
+
+/* As Core_Export.h header is generated during build, the required CORE_EXPORT
+ * definition might not exist due to missing header file. In order to prevent
+ * syntax errors cause by undefined CORE_EXPORT, define temporary blank one */
+#ifndef CORE_EXPORT
+	#define CORE_EXPORT
+	#define CORE_NO_EXPORT
+#endif
+
+namespace Core
+{
+	namespace Detail
+	{
+		/**
+		 * @brief Small memory block pool
+		 *
+		 * Recycles small memory blocks (shared states of the futures, oversized jobs) used by the ThreadPool
+		 * in order to keep the job submission free of heap allocations once the application runs steadily.
+		 *
+		 * Blocks are sorted into size classes and cached in thread local free lists, so no synchronization
+		 * is needed when the block is released by the thread which allocated it. Block released by another
+		 * thread is returned to the allocating thread through a lock free list, so the blocks allocated when
+		 * submitting from outside of the pool are reused once the workers release them. The cache of the exited
+		 * thread is taken over by the next new thread. Blocks bigger than the largest size class are taken
+		 * from the heap.
+		 */
+		class CORE_EXPORT BlockPool
+		{
+		public:
+			/**
+			 * @brief Allocate memory block
+			 *
+			 * @param [in] Size		Size of the block in bytes
+			 *
+			 * @returns Memory block aligned for any fundamental type
+			 *
+			 * @throws <std::bad_alloc>	Block could not be allocated
+			 */
+			static void * allocate( std::size_t Size );
+
+			/**
+			 * @brief Release memory block
+			 *
+			 * @param [in] Block	Block returned by allocate()
+			 * @param [in] Size		Size of the block as passed to allocate()
+			 */
+			static void deallocate( void * Block, std::size_t Size ) noexcept;
+		};
+
+		/**
+		 * @brief Allocator taking the memory from the BlockPool
+		 *
+		 * Stateless allocator to be passed to standard library facilities supporting custom allocators
+		 * (e.g. std::promise).
+		 *
+		 * @tparam T	Allocated type
+		 */
+		template<typename T>
+		class PoolAllocator
+		{
+		public:
+			using value_type = T;
+
+			PoolAllocator( void ) noexcept = default;
+
+			template<typename OTHER>
+			PoolAllocator( const PoolAllocator<OTHER> & ) noexcept
+			{}
+
+			T * allocate( std::size_t Count )
+			{
+				return( static_cast<T *>( BlockPool::allocate( Count * sizeof( T ) ) ) );
+			}
+
+			void deallocate( T * Block, std::size_t Count ) noexcept
+			{
+				BlockPool::deallocate( Block, Count * sizeof( T ) );
+			}
+
+			template<typename OTHER>
+			bool operator == ( const PoolAllocator<OTHER> & ) const noexcept
+			{
+				return( true );
+			}
+
+			template<typename OTHER>
+			bool operator != ( const PoolAllocator<OTHER> & ) const noexcept
+			{
+				return( false );
+			}
+		};
+	}
+}
+
+#endif /* CORE_THREADPOOL_POOLALLOCATOR_H_ */
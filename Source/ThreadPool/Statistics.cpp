@@ -0,0 +1,218 @@
+/*
+ * Statistics.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+/* Standard library inclusions */
+#include <algorithm>
+#include <cmath>
+
+/* Project specific inclusions */
+#include "ThreadPool/Statistics.h"
+
+using namespace Core;
+
+namespace
+{
+	/* Prints the nanoseconds in human readable units */
+	struct Duration
+	{
+		std::uint64_t mNanoseconds;
+	};
+
+	std::ostream & operator << ( std::ostream & Stream, const Duration & Value )
+	{
+		if( Value.mNanoseconds < 10000 )
+		{
+			return( Stream << Value.mNanoseconds << " ns" );
+		}
+
+		if( Value.mNanoseconds < 10000000 )
+		{
+			return( Stream << ( Value.mNanoseconds / 1000 ) << " us" );
+		}
+
+		return( Stream << ( Value.mNanoseconds / 1000000 ) << " ms" );
+	}
+
+	template<typename VALUE>
+	void printHistogram( std::ostream & Stream, const char * Name, const Histogram & Values, VALUE ( * Format )( std::uint64_t ) )
+	{
+		Stream << "  " << Name << ": count " << Values.getCount()
+			<< ", mean " << Format( static_cast<std::uint64_t>( Values.getMean() ) )
+			<< ", p50 " << Format( Values.getPercentile( 0.5 ) )
+			<< ", p90 " << Format( Values.getPercentile( 0.9 ) )
+			<< ", p99 " << Format( Values.getPercentile( 0.99 ) )
+			<< ", max " << Format( Values.getMax() ) << std::endl;
+	}
+
+	Duration formatDuration( std::uint64_t Value )
+	{
+		return( Duration{ Value } );
+	}
+
+	std::uint64_t formatCount( std::uint64_t Value )
+	{
+		return( Value );
+	}
+}
+
+CORE_EXPORT Histogram::Histogram( void )
+	:	mBuckets{},
+		mSum( 0 ),
+		mMax( 0 )
+{}
+
+CORE_EXPORT std::size_t Histogram::getBucket( std::uint64_t Value )
+{
+	std::size_t tBucket = 0;
+
+	/* Number of significant bits of the value */
+	for( ; Value != 0; Value >>= 1 )
+	{
+		++tBucket;
+	}
+
+	return( std::min( tBucket, BucketCount - 1 ) );
+}
+
+CORE_EXPORT std::uint64_t Histogram::getBucketUpperBound( std::size_t Bucket )
+{
+	return( ( Bucket == 0 ) ? 0 : ( ( std::uint64_t( 1 ) << Bucket ) - 1 ) );
+}
+
+CORE_EXPORT void Histogram::add( std::uint64_t Value )
+{
+	++( this->mBuckets[ getBucket( Value ) ] );
+
+	this->mSum += Value;
+	this->mMax = std::max( this->mMax, Value );
+}
+
+CORE_EXPORT void Histogram::merge( const Histogram & Other )
+{
+	for( std::size_t tBucket = 0; tBucket < BucketCount; ++tBucket )
+	{
+		this->mBuckets[ tBucket ] += Other.mBuckets[ tBucket ];
+	}
+
+	this->mSum += Other.mSum;
+	this->mMax = std::max( this->mMax, Other.mMax );
+}
+
+CORE_EXPORT std::uint64_t Histogram::getCount( void ) const
+{
+	std::uint64_t tCount = 0;
+
+	for( std::uint64_t tBucketCount : this->mBuckets )
+	{
+		tCount += tBucketCount;
+	}
+
+	return( tCount );
+}
+
+CORE_EXPORT double Histogram::getMean( void ) const
+{
+	std::uint64_t tCount = this->getCount();
+
+	return( ( tCount > 0 ) ? ( static_cast<double>( this->mSum ) / static_cast<double>( tCount ) ) : 0.0 );
+}
+
+CORE_EXPORT std::uint64_t Histogram::getPercentile( double Fraction ) const
+{
+	std::uint64_t tCount = this->getCount();
+
+	if( tCount == 0 )
+	{
+		return( 0 );
+	}
+
+	/* Rank of the value being the percentile, counted from 1 */
+	std::uint64_t tRank = std::max<std::uint64_t>( static_cast<std::uint64_t>( std::ceil( Fraction * static_cast<double>( tCount ) ) ), 1 );
+	std::uint64_t tCounted = 0;
+
+	for( std::size_t tBucket = 0; tBucket < BucketCount; ++tBucket )
+	{
+		tCounted += this->mBuckets[ tBucket ];
+
+		if( tCounted >= tRank )
+		{
+			/* The maximum is more precise than the upper bound of the last bucket used */
+			return( std::min( getBucketUpperBound( tBucket ), this->mMax ) );
+		}
+	}
+
+	return( this->mMax );
+}
+
+CORE_EXPORT HistogramRecorder::HistogramRecorder( void )
+	:	mSum( 0 ),
+		mMax( 0 )
+{
+	for( std::atomic<std::uint64_t> & tBucket : this->mBuckets )
+	{
+		tBucket.store( 0, std::memory_order_relaxed );
+	}
+}
+
+CORE_EXPORT void HistogramRecorder::record( std::uint64_t Value )
+{
+	std::atomic<std::uint64_t> & tBucket = this->mBuckets[ Histogram::getBucket( Value ) ];
+
+	/* Single writer, so plain load and store do not lose any update */
+	tBucket.store( tBucket.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+
+	this->mSum.store( this->mSum.load( std::memory_order_relaxed ) + Value, std::memory_order_relaxed );
+
+	if( Value > this->mMax.load( std::memory_order_relaxed ) )
+	{
+		this->mMax.store( Value, std::memory_order_relaxed );
+	}
+}
+
+CORE_EXPORT void HistogramRecorder::collect( Histogram & Target ) const
+{
+	for( std::size_t tBucket = 0; tBucket < Histogram::BucketCount; ++tBucket )
+	{
+		Target.mBuckets[ tBucket ] += this->mBuckets[ tBucket ].load( std::memory_order_relaxed );
+	}
+
+	Target.mSum += this->mSum.load( std::memory_order_relaxed );
+	Target.mMax = std::max( Target.mMax, this->mMax.load( std::memory_order_relaxed ) );
+}
+
+CORE_EXPORT void HistogramRecorder::reset( void )
+{
+	for( std::atomic<std::uint64_t> & tBucket : this->mBuckets )
+	{
+		tBucket.store( 0, std::memory_order_relaxed );
+	}
+
+	this->mSum.store( 0, std::memory_order_relaxed );
+	this->mMax.store( 0, std::memory_order_relaxed );
+}
+
+CORE_EXPORT std::ostream & Core::operator << ( std::ostream & Stream, const ThreadPoolStatistics & Statistics )
+{
+	Stream << "ThreadPool statistics for " << Duration{ static_cast<std::uint64_t>( Statistics.mPeriod.count() ) }
+		<< ", " << Statistics.mWaitingJobs << " jobs waiting, " << Statistics.mFailedJobs << " failed, "
+		<< Statistics.mCancelledJobs << " cancelled:" << std::endl;
+
+	printHistogram( Stream, "wait time", Statistics.mWaitTime, formatDuration );
+	printHistogram( Stream, "run time", Statistics.mRunTime, formatDuration );
+	printHistogram( Stream, "queue depth", Statistics.mQueueDepth, formatCount );
+
+	for( std::size_t tWorker = 0; tWorker < Statistics.mWorkers.size(); ++tWorker )
+	{
+		const ThreadPoolStatistics::Worker & tStatistics = Statistics.mWorkers[ tWorker ];
+
+		Stream << "  worker " << tWorker << ": " << tStatistics.mJobsRun << " jobs, busy "
+			<< Duration{ static_cast<std::uint64_t>( tStatistics.mBusyTime.count() ) }
+			<< " (" << ( std::round( 1000.0 * tStatistics.mUtilisation ) / 10.0 ) << " %)" << std::endl;
+	}
+
+	return( Stream );
+}
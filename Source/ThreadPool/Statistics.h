@@ -0,0 +1,183 @@
+/*
+ * Statistics.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_STATISTICS_H_
+#define CORE_THREADPOOL_STATISTICS_H_
+
+/* Standard library inclusions */
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/* Shared library support */
+#include "Core_Export.h"
+
+/* As Core_Export.h header is generated during build, the required CORE_EXPORT
+ * definition might not exist due to missing header file. In order to prevent
+ * syntax errors cause by undefined CORE_EXPORT, define temporary blank one */
+#ifndef CORE_EXPORT
+	#define CORE_EXPORT
+	#define CORE_NO_EXPORT
+#endif
+
+namespace Core
+{
+	/**
+	 * @brief Histogram of the values sampled
+	 *
+	 * Values are sorted into power of two buckets. Bucket 0 counts the zero values, bucket N counts the values
+	 * of <2^(N-1), 2^N). The last bucket counts all the values bigger than that as well. Percentiles are therefore
+	 * approximate, they are reported as the upper bound of the bucket they fall into.
+	 */
+	class CORE_EXPORT Histogram
+	{
+	public:
+		static constexpr std::size_t BucketCount = 48;
+
+		using TBuckets = std::array<std::uint64_t, BucketCount>;
+
+		Histogram( void );
+
+		/**
+		 * @brief Get the bucket the value falls into
+		 */
+		static std::size_t getBucket( std::uint64_t Value );
+
+		/**
+		 * @brief Get the biggest value counted by the bucket
+		 */
+		static std::uint64_t getBucketUpperBound( std::size_t Bucket );
+
+		void add( std::uint64_t Value );
+
+		/**
+		 * @brief Add all the values sampled by another histogram
+		 */
+		void merge( const Histogram & Other );
+
+		const TBuckets & getBuckets( void ) const
+		{
+			return( this->mBuckets );
+		}
+
+		std::uint64_t getCount( void ) const;
+
+		std::uint64_t getSum( void ) const
+		{
+			return( this->mSum );
+		}
+
+		std::uint64_t getMax( void ) const
+		{
+			return( this->mMax );
+		}
+
+		double getMean( void ) const;
+
+		/**
+		 * @brief Get the approximate percentile
+		 *
+		 * @param [in] Fraction		Percentile as a fraction of <0, 1> (e.g. 0.99 for 99th percentile)
+		 *
+		 * @returns Upper bound of the bucket the percentile falls into, zero for empty histogram
+		 */
+		std::uint64_t getPercentile( double Fraction ) const;
+
+	private:
+		friend class HistogramRecorder;
+
+		TBuckets		mBuckets;
+
+		std::uint64_t	mSum;
+
+		std::uint64_t	mMax;
+	};
+
+	/**
+	 * @brief Histogram recorder
+	 *
+	 * Lock-free histogram to be written by single thread and read by any other thread. Single writer does not need
+	 * any read-modify-write operation, so recording the value costs just a few relaxed loads and stores.
+	 */
+	class CORE_EXPORT HistogramRecorder
+	{
+	public:
+		HistogramRecorder( void );
+
+		/* Must be called by the owning thread only */
+		void record( std::uint64_t Value );
+
+		/* Adds the values recorded so far to the Target histogram. May be called by any thread */
+		void collect( Histogram & Target ) const;
+
+		/* May be called by any thread, values being recorded meanwhile may be lost */
+		void reset( void );
+
+	private:
+		std::array<std::atomic<std::uint64_t>, Histogram::BucketCount>	mBuckets;
+
+		std::atomic<std::uint64_t>	mSum;
+
+		std::atomic<std::uint64_t>	mMax;
+	};
+
+	/**
+	 * @brief Snapshot of the ThreadPool statistics
+	 *
+	 * Statistics are collected since the ThreadPool start or since the last reset. Histograms of the times are
+	 * sampled in nanoseconds.
+	 */
+	struct CORE_EXPORT ThreadPoolStatistics
+	{
+		struct Worker
+		{
+			/* Number of jobs run by the worker, including the jobs run while helping another job to wait */
+			std::uint64_t				mJobsRun;
+
+			/* Time spent running the jobs */
+			std::chrono::nanoseconds	mBusyTime;
+
+			/* Busy time as a fraction of the statistics period */
+			double						mUtilisation;
+		};
+
+		/* Time the statistics are collected for */
+		std::chrono::nanoseconds	mPeriod;
+
+		/* Time the jobs waited in the queues, from the enqueue to the start (head-of-line blocking shows here) */
+		Histogram					mWaitTime;
+
+		/* Time the jobs were running for. Time of the jobs run while another job was waiting is included in both */
+		Histogram					mRunTime;
+
+		/* Number of jobs queued, sampled every time a job is taken out of the queue */
+		Histogram					mQueueDepth;
+
+		/* Running workers */
+		std::vector<Worker>			mWorkers;
+
+		/* Number of jobs waiting to be executed at the time of the snapshot */
+		std::size_t					mWaitingJobs;
+
+		/* Number of jobs failed with an exception, a failure rethrown by a continuation is counted again */
+		std::uint64_t				mFailedJobs;
+
+		/* Number of jobs failed with Core::Exception::OperationCancelled */
+		std::uint64_t				mCancelledJobs;
+	};
+
+	/**
+	 * @brief Print statistics summary
+	 */
+	CORE_EXPORT std::ostream & operator << ( std::ostream & Stream, const ThreadPoolStatistics & Statistics );
+}
+
+#endif /* CORE_THREADPOOL_STATISTICS_H_ */
@@ -0,0 +1,265 @@
+/*
+ * Task.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_TASK_H_
+#define CORE_THREADPOOL_TASK_H_
+
+/* Standard library inclusions */
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/* Project specific inclusions */
+#include "ThreadPool/PoolAllocator.h"
+#include "ThreadPool/Failure.h"
+
+namespace Core
+{
+	namespace Detail
+	{
+		/**
+		 * @brief Move-only type-erased job
+		 *
+		 * Replacement of std::function<void()> used for the ThreadPool jobs. Small callables (which is the
+		 * usual case of a function bound to a few arguments) are stored inline so enqueueing the job does not
+		 * allocate at all. Bigger callables are stored in a block taken from the BlockPool.
+		 *
+		 * Unlike std::function, the callable does not have to be copyable, so a std::promise may be bound in.
+		 */
+		class Task
+		{
+		public:
+			/* Size of the inline storage */
+			static constexpr std::size_t BufferSize = 96;
+
+			Task( void ) noexcept
+				:	mOperations( nullptr )
+			{}
+
+			template<typename FUNCTION, typename = typename std::enable_if<!std::is_same<typename std::decay<FUNCTION>::type, Task>::value>::type>
+			Task( FUNCTION && Function )
+				:	mOperations( & Operations<typename std::decay<FUNCTION>::type>::Table )
+			{
+				Operations<typename std::decay<FUNCTION>::type>::construct( this->mBuffer, std::forward<FUNCTION>( Function ) );
+			}
+
+			Task( Task && Other ) noexcept
+				:	mOperations( Other.mOperations )
+			{
+				if( this->mOperations != nullptr )
+				{
+					this->mOperations->mRelocate( Other.mBuffer, this->mBuffer );
+					Other.mOperations = nullptr;
+				}
+			}
+
+			Task & operator = ( Task && Other ) noexcept
+			{
+				if( this != & Other )
+				{
+					this->reset();
+
+					if( Other.mOperations != nullptr )
+					{
+						Other.mOperations->mRelocate( Other.mBuffer, this->mBuffer );
+						this->mOperations = Other.mOperations;
+						Other.mOperations = nullptr;
+					}
+				}
+
+				return( *this );
+			}
+
+			Task( const Task & ) = delete;
+
+			Task & operator = ( const Task & ) = delete;
+
+			~Task( void )
+			{
+				this->reset();
+			}
+
+			explicit operator bool ( void ) const noexcept
+			{
+				return( this->mOperations != nullptr );
+			}
+
+			void operator () ( void )
+			{
+				this->mOperations->mInvoke( this->mBuffer );
+			}
+
+		private:
+			struct OperationsTable
+			{
+				void ( * mInvoke )( void * Storage );
+				/* Move-constructs the callable into To and destroys the one in From */
+				void ( * mRelocate )( void * From, void * To ) noexcept;
+				void ( * mDestroy )( void * Storage ) noexcept;
+			};
+
+			/* Callables fitting the buffer and being nothrow movable are stored inline, the others are referenced */
+			template<typename FUNCTION>
+			using IsStoredInline = std::integral_constant<bool, ( sizeof( FUNCTION ) <= BufferSize ) && ( alignof( FUNCTION ) <= alignof( std::max_align_t ) ) && std::is_nothrow_move_constructible<FUNCTION>::value>;
+
+			template<typename FUNCTION, bool INLINE = IsStoredInline<FUNCTION>::value>
+			struct Operations
+			{
+				template<typename ARGUMENT>
+				static void construct( void * Storage, ARGUMENT && Function )
+				{
+					new( Storage ) FUNCTION( std::forward<ARGUMENT>( Function ) );
+				}
+
+				static void invoke( void * Storage )
+				{
+					( * static_cast<FUNCTION *>( Storage ) )();
+				}
+
+				static void relocate( void * From, void * To ) noexcept
+				{
+					new( To ) FUNCTION( std::move( * static_cast<FUNCTION *>( From ) ) );
+					static_cast<FUNCTION *>( From )->~FUNCTION();
+				}
+
+				static void destroy( void * Storage ) noexcept
+				{
+					static_cast<FUNCTION *>( Storage )->~FUNCTION();
+				}
+
+				static constexpr OperationsTable Table = { & invoke, & relocate, & destroy };
+			};
+
+			template<typename FUNCTION>
+			struct Operations<FUNCTION, false>
+			{
+				template<typename ARGUMENT>
+				static void construct( void * Storage, ARGUMENT && Function )
+				{
+					void * tBlock = BlockPool::allocate( sizeof( FUNCTION ) );
+
+					try
+					{
+						* static_cast<FUNCTION **>( Storage ) = new( tBlock ) FUNCTION( std::forward<ARGUMENT>( Function ) );
+					}
+					catch( ... )
+					{
+						BlockPool::deallocate( tBlock, sizeof( FUNCTION ) );
+						throw;
+					}
+				}
+
+				static void invoke( void * Storage )
+				{
+					( ** static_cast<FUNCTION **>( Storage ) )();
+				}
+
+				static void relocate( void * From, void * To ) noexcept
+				{
+					* static_cast<FUNCTION **>( To ) = * static_cast<FUNCTION **>( From );
+				}
+
+				static void destroy( void * Storage ) noexcept
+				{
+					FUNCTION * tFunction = * static_cast<FUNCTION **>( Storage );
+
+					tFunction->~FUNCTION();
+					BlockPool::deallocate( tFunction, sizeof( FUNCTION ) );
+				}
+
+				static constexpr OperationsTable Table = { & invoke, & relocate, & destroy };
+			};
+
+			void reset( void ) noexcept
+			{
+				if( this->mOperations != nullptr )
+				{
+					this->mOperations->mDestroy( this->mBuffer );
+					this->mOperations = nullptr;
+				}
+			}
+
+			const OperationsTable * mOperations;
+
+			alignas( std::max_align_t ) unsigned char mBuffer[ BufferSize ];
+		};
+
+		template<typename FUNCTION, bool INLINE>
+		constexpr Task::OperationsTable Task::Operations<FUNCTION, INLINE>::Table;
+
+		template<typename FUNCTION>
+		constexpr Task::OperationsTable Task::Operations<FUNCTION, false>::Table;
+
+		/**
+		 * @brief Function call bound to its arguments and to the promise of its result
+		 *
+		 * Move-only replacement of std::packaged_task<RESULT()> holding std::bind() result. The arguments are
+		 * passed to the function as lvalues, the same way std::bind() does. The shared state of the promise is
+		 * taken from the BlockPool.
+		 *
+		 * @tparam RESULT		Function result type
+		 * @tparam FUNCTION		Function type
+		 * @tparam ARGUMENTS	Argument types
+		 */
+		template<typename RESULT, typename FUNCTION, typename... ARGUMENTS>
+		class PackagedCall
+		{
+		public:
+			template<typename FUNCTION_ARGUMENT, typename... ARGUMENT_ARGUMENTS>
+			explicit PackagedCall( FUNCTION_ARGUMENT && Function, ARGUMENT_ARGUMENTS && ...Arguments )
+				:	mPromise( std::allocator_arg, PoolAllocator<char>() ),
+					mCall( std::forward<FUNCTION_ARGUMENT>( Function ), std::forward<ARGUMENT_ARGUMENTS>( Arguments )... )
+			{}
+
+			PackagedCall( PackagedCall && ) = default;
+
+			std::future<RESULT> getFuture( void )
+			{
+				return( this->mPromise.get_future() );
+			}
+
+			void operator () ( void )
+			{
+				try
+				{
+					this->call( std::is_void<RESULT>(), std::index_sequence_for<ARGUMENTS...>() );
+				}
+				catch( ... )
+				{
+					reportJobFailure( std::current_exception() );
+					this->mPromise.set_exception( std::current_exception() );
+				}
+			}
+
+		private:
+			template<std::size_t... INDICES>
+			void call( std::false_type, std::index_sequence<INDICES...> )
+			{
+				this->mPromise.set_value( std::invoke( std::get<0>( this->mCall ), std::get<INDICES + 1>( this->mCall )... ) );
+			}
+
+			template<std::size_t... INDICES>
+			void call( std::true_type, std::index_sequence<INDICES...> )
+			{
+				std::invoke( std::get<0>( this->mCall ), std::get<INDICES + 1>( this->mCall )... );
+				this->mPromise.set_value();
+			}
+
+			std::promise<RESULT>	mPromise;
+
+			/* Function followed by its arguments */
+			std::tuple<FUNCTION, ARGUMENTS...>	mCall;
+		};
+	}
+}
+
+#endif /* CORE_THREADPOOL_TASK_H_ */
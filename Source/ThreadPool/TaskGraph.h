@@ -0,0 +1,789 @@
+/*
+ * TaskGraph.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_TASKGRAPH_H_
+#define CORE_THREADPOOL_TASKGRAPH_H_
+
+/* Standard library inclusions */
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/* Project specific inclusions */
+#include "ThreadPool/ThreadPool.h"
+#include "ThreadPool/Future.h"
+#include "ThreadPool/Cancellation.h"
+#include "ThreadPool/PoolAllocator.h"
+#include "ThreadPool/Exception.h"
+
+namespace Core
+{
+	namespace Detail
+	{
+		/**
+		 * @brief Task graph node
+		 *
+		 * Common base of all the task graph nodes. Counts the predecessors not finished yet and keeps the
+		 * successors to be notified once this node is finished.
+		 */
+		class TaskGraphNode
+			:	public std::enable_shared_from_this<TaskGraphNode>
+		{
+		public:
+			TaskGraphNode( ThreadPool & Pool, const CancellationToken & Token )
+				:	mPool( Pool ),
+					mToken( Token ),
+					mPendingPredecessors( 0 ),
+					mFailed( false ),
+					mStarted( false )
+			{}
+
+			virtual ~TaskGraphNode( void ) = default;
+
+			/**
+			 * @brief Run the node and its successors
+			 *
+			 * Once the node is finished, the successors having all the predecessors finished are ready. The first
+			 * ready successor is run by the same thread right away (continuation), the other ones are added to the
+			 * thread pool. Nobody ever waits for anything.
+			 */
+			static void run( std::shared_ptr<TaskGraphNode> Node )
+			{
+				while( Node )
+				{
+					/* Nodes of the cancelled graph are not run any more, they fail the same way as if any predecessor failed */
+					if( ( !Node->mException ) && Node->mToken.isCancelled() )
+					{
+						Node->mException = CancellationToken::getCancelledException();
+					}
+
+					/* Asynchronous node finishes later, it releases its successors on its own */
+					if( !Node->execute() )
+					{
+						return;
+					}
+
+					Node = release( * Node );
+				}
+			}
+
+			/**
+			 * @brief Hand the finished node over to its successors
+			 *
+			 * Successors becoming ready are added to the thread pool, except for the first one, which is returned to
+			 * be run by the calling thread.
+			 */
+			static std::shared_ptr<TaskGraphNode> release( TaskGraphNode & Node )
+			{
+				/* Successors are released here, which breaks the reference cycles between the nodes */
+				std::vector<std::shared_ptr<TaskGraphNode>> tSuccessors = std::move( Node.mSuccessors );
+				std::shared_ptr<TaskGraphNode> tContinuation;
+
+				for( std::shared_ptr<TaskGraphNode> & tSuccessor : tSuccessors )
+				{
+					/* Failure is handed over before the successor may become ready */
+					if( Node.mException && ( !tSuccessor->mFailed.exchange( true ) ) )
+					{
+						tSuccessor->mException = Node.mException;
+					}
+
+					if( --( tSuccessor->mPendingPredecessors ) == 0 )
+					{
+						if( tContinuation )
+						{
+							schedule( std::move( tSuccessor ) );
+						}
+						else
+						{
+							tContinuation = std::move( tSuccessor );
+						}
+					}
+				}
+
+				return( tContinuation );
+			}
+
+			/**
+			 * @brief Add the node to its thread pool
+			 *
+			 * Once the pool is stopped, the node is run right away, so the graph is finished anyway.
+			 */
+			static void schedule( std::shared_ptr<TaskGraphNode> Node )
+			{
+				ThreadPool & tPool = Node->mPool;
+
+				addOrRun( tPool, [Node]() { run( Node ); } );
+			}
+
+			ThreadPool &								mPool;
+
+			/* Token of the graph the node belongs to */
+			CancellationToken							mToken;
+
+			/* Number of predecessors not finished yet. Node is ready once it reaches zero */
+			std::atomic<std::size_t>					mPendingPredecessors;
+
+			/* Nodes waiting for this node */
+			std::vector<std::shared_ptr<TaskGraphNode>>	mSuccessors;
+
+			/* Set by the first failed predecessor */
+			std::atomic<bool>							mFailed;
+
+			/* Exception thrown by the node or by any of its predecessors */
+			std::exception_ptr							mException;
+
+			/* Set once the graph is run, the node must not be modified any more */
+			bool										mStarted;
+
+		protected:
+			/**
+			 * @brief Run the node's function unless any predecessor failed
+			 *
+			 * @returns true	{Node is finished}
+			 * @returns false	{Node finishes asynchronously and runs its successors then}
+			 */
+			virtual bool execute( void ) = 0;
+		};
+
+		/**
+		 * @brief Task graph node producing a result
+		 *
+		 * The result is kept by the node to be passed to the successors. Alternatively, it may be moved to the future
+		 * once requested.
+		 *
+		 * Every successor consuming the result gets its own instance, as the successors run in parallel and may move
+		 * the result out. The first one gets the result itself, the others its copies made once the node is finished.
+		 *
+		 * @tparam RESULT	Node result type
+		 */
+		template<typename RESULT>
+		class TaskGraphResultNode
+			:	public TaskGraphNode
+		{
+		public:
+			using ResultType = RESULT;
+
+			TaskGraphResultNode( ThreadPool & Pool, const CancellationToken & Token )
+				:	TaskGraphNode( Pool, Token ),
+					mPromise( Pool ),
+					mHasFuture( false ),
+					mValueSuccessors( 0 ),
+					mResultsTaken( 0 )
+			{}
+
+			/**
+			 * @brief Take the result instance of single successor
+			 *
+			 * Must be called once per successor consuming the result, and only once the node succeeded.
+			 */
+			RESULT & takeResult( void )
+			{
+				std::size_t tConsumer = this->mResultsTaken++;
+
+				return( ( tConsumer == 0 ) ? * this->mResult : this->mResultCopies[ tConsumer - 1 ] );
+			}
+
+			/* Stores the result and hands it over to the future, if requested */
+			template<typename FUNCTION, typename... ARGUMENTS>
+			void complete( FUNCTION && Function, ARGUMENTS && ...Arguments )
+			{
+				if( !this->mException )
+				{
+					try
+					{
+						this->mResult.emplace( std::invoke( std::forward<FUNCTION>( Function ), std::forward<ARGUMENTS>( Arguments )... ) );
+
+						/* The successors are not ready yet, so the result is not touched by anybody while being copied */
+						if constexpr( std::is_copy_constructible<RESULT>::value )
+						{
+							for( std::size_t tCopy = 1; tCopy < this->mValueSuccessors; ++tCopy )
+							{
+								this->mResultCopies.push_back( * this->mResult );
+							}
+						}
+					}
+					catch( ... )
+					{
+						this->mException = std::current_exception();
+
+						reportJobFailure( this->mException );
+					}
+				}
+
+				if( this->mHasFuture )
+				{
+					this->mException ? this->mPromise.setException( this->mException ) : this->mPromise.setValue( std::move( * this->mResult ) );
+				}
+			}
+
+			std::optional<RESULT>	mResult;
+
+			Promise<RESULT>		mPromise;
+
+			/* Future of the result was requested, the result is moved there */
+			bool					mHasFuture;
+
+			/* Number of successors consuming the result */
+			std::size_t				mValueSuccessors;
+
+			/* Result instances of the successors but the first one */
+			std::vector<RESULT>		mResultCopies;
+
+			/* Number of successors which took their result instance */
+			std::atomic<std::size_t>	mResultsTaken;
+		};
+
+		template<>
+		class TaskGraphResultNode<void>
+			:	public TaskGraphNode
+		{
+		public:
+			using ResultType = void;
+
+			TaskGraphResultNode( ThreadPool & Pool, const CancellationToken & Token )
+				:	TaskGraphNode( Pool, Token ),
+					mPromise( Pool ),
+					mHasFuture( false ),
+					mValueSuccessors( 0 )
+			{}
+
+			void takeResult( void )
+			{}
+
+			template<typename FUNCTION, typename... ARGUMENTS>
+			void complete( FUNCTION && Function, ARGUMENTS && ...Arguments )
+			{
+				if( !this->mException )
+				{
+					try
+					{
+						std::invoke( std::forward<FUNCTION>( Function ), std::forward<ARGUMENTS>( Arguments )... );
+					}
+					catch( ... )
+					{
+						this->mException = std::current_exception();
+
+						reportJobFailure( this->mException );
+					}
+				}
+
+				if( this->mHasFuture )
+				{
+					this->mException ? this->mPromise.setException( this->mException ) : this->mPromise.setValue();
+				}
+			}
+
+			Promise<void>			mPromise;
+
+			bool					mHasFuture;
+
+			std::size_t				mValueSuccessors;
+		};
+
+		/**
+		 * @brief Task graph node running a function
+		 *
+		 * The function is called with the results of the predecessors as lvalue references, so it may move them out.
+		 * The function is not called once any predecessor failed, the node fails the same way then.
+		 *
+		 * @tparam RESULT			Function result type
+		 * @tparam FUNCTION			Function type
+		 * @tparam PREDECESSORS		Result types of the predecessors passing their results to the function
+		 */
+		template<typename RESULT, typename FUNCTION, typename... PREDECESSORS>
+		class TaskGraphFunctionNode
+			:	public TaskGraphResultNode<RESULT>
+		{
+		public:
+			template<typename FUNCTION_ARGUMENT>
+			TaskGraphFunctionNode( ThreadPool & Pool, const CancellationToken & Token, FUNCTION_ARGUMENT && Function, std::shared_ptr<TaskGraphResultNode<PREDECESSORS>>... Predecessors )
+				:	TaskGraphResultNode<RESULT>( Pool, Token ),
+					mFunction( std::forward<FUNCTION_ARGUMENT>( Function ) ),
+					mPredecessors( std::move( Predecessors )... )
+			{}
+
+		protected:
+			bool execute( void ) override
+			{
+				this->execute( std::index_sequence_for<PREDECESSORS...>() );
+
+				/* Neither the function nor the predecessors are needed any more */
+				this->mPredecessors = std::tuple<std::shared_ptr<TaskGraphResultNode<PREDECESSORS>>...>();
+
+				return( true );
+			}
+
+		private:
+			template<std::size_t... INDICES>
+			void execute( std::index_sequence<INDICES...> )
+			{
+				/* The results of the failed predecessors do not exist, so the arguments cannot be even taken. The function
+				 * is not called for the failed node */
+				if( this->mException )
+				{
+					this->complete( []() -> RESULT { std::terminate(); } );
+
+					return;
+				}
+
+				this->complete( this->mFunction, std::get<INDICES>( this->mPredecessors )->takeResult()... );
+			}
+
+			FUNCTION	mFunction;
+
+			std::tuple<std::shared_ptr<TaskGraphResultNode<PREDECESSORS>>...>	mPredecessors;
+		};
+
+		/* Result type of the future returned by the function of the asynchronous node */
+		template<typename FUTURE>
+		struct AsyncNodeResult;
+
+		template<typename RESULT>
+		struct AsyncNodeResult<Future<RESULT>>
+		{
+			using type = RESULT;
+		};
+
+		/**
+		 * @brief Task graph node running a function which returns a future
+		 *
+		 * The function just starts the operation. The node is finished once the future is ready, its successors are
+		 * added to the thread pool then, so no worker is blocked while the operation is running.
+		 *
+		 * @tparam RESULT			Result type of the future
+		 * @tparam FUNCTION			Function type
+		 * @tparam PREDECESSORS		Result types of the predecessors passing their results to the function
+		 */
+		template<typename RESULT, typename FUNCTION, typename... PREDECESSORS>
+		class TaskGraphAsyncNode
+			:	public TaskGraphResultNode<RESULT>
+		{
+		public:
+			template<typename FUNCTION_ARGUMENT>
+			TaskGraphAsyncNode( ThreadPool & Pool, const CancellationToken & Token, FUNCTION_ARGUMENT && Function, std::shared_ptr<TaskGraphResultNode<PREDECESSORS>>... Predecessors )
+				:	TaskGraphResultNode<RESULT>( Pool, Token ),
+					mFunction( std::forward<FUNCTION_ARGUMENT>( Function ) ),
+					mPredecessors( std::move( Predecessors )... )
+			{}
+
+		protected:
+			bool execute( void ) override
+			{
+				Future<RESULT> tFuture;
+
+				if( !this->mException )
+				{
+					try
+					{
+						tFuture = this->start( std::index_sequence_for<PREDECESSORS...>() );
+
+						FutureAccess::getState( tFuture );
+					}
+					catch( ... )
+					{
+						this->mException = std::current_exception();
+
+						reportJobFailure( this->mException );
+					}
+				}
+
+				/* Neither the function nor the predecessors are needed any more */
+				this->mPredecessors = std::tuple<std::shared_ptr<TaskGraphResultNode<PREDECESSORS>>...>();
+
+				if( this->mException )
+				{
+					/* The function is not called for the failed node */
+					this->complete( [&tFuture]() { return( tFuture.get() ); } );
+
+					return( true );
+				}
+
+				std::shared_ptr<FutureState<RESULT>> tState = FutureAccess::getState( tFuture );
+
+				/* The continuation keeps the node alive until the future is ready. The node is finished by the thread
+				 * pool, so the thread setting the result is not delayed by the successors */
+				tState->addContinuation(
+					[ Node = std::static_pointer_cast<TaskGraphAsyncNode>( this->shared_from_this() ), State = tState ]() mutable
+					{
+						ThreadPool & tPool = Node->mPool;
+
+						addOrRun( tPool,
+							[ Node = std::move( Node ), State = std::move( State ) ]()
+							{
+								/* Failure of the operation was accounted by whoever failed it */
+								Node->mException = State->getException();
+
+								Node->complete( [&State]() { return( State->get() ); } );
+
+								TaskGraphNode::run( TaskGraphNode::release( * Node ) );
+							} );
+					} );
+
+				return( false );
+			}
+
+		private:
+			template<std::size_t... INDICES>
+			Future<RESULT> start( std::index_sequence<INDICES...> )
+			{
+				return( std::invoke( this->mFunction, std::get<INDICES>( this->mPredecessors )->takeResult()... ) );
+			}
+
+			FUNCTION	mFunction;
+
+			std::tuple<std::shared_ptr<TaskGraphResultNode<PREDECESSORS>>...>	mPredecessors;
+		};
+	}
+
+	/**
+	 * @brief Task dependency graph
+	 *
+	 * Describes the jobs and the dependencies between them explicitly, so the jobs are not required to block while
+	 * waiting for the results of the others. Every node is added to the thread pool once all its predecessors are
+	 * finished, and the results of the predecessors are passed to it directly.
+	 *
+	 * Once a node fails (throws), all its successors fail with the same exception without being run.
+	 *
+	 * The graph must be fully built before it is run. The graph instance itself may be destroyed right after run()
+	 * as the running nodes keep each other alive.
+	 *
+	 * Example usage:
+	 * @code{.cpp}
+	 *      Core::TaskGraph Graph;
+	 *
+	 *      auto A = Graph.add( [](){ return 1; } );
+	 *      auto B = Graph.add( [](){ return 2; } );
+	 *      auto Sum = Graph.add( []( int & a, int & b ){ return a + b; }, A, B );
+	 *
+	 *      Core::Future<int> Result = Sum.getFuture();
+	 *
+	 *      Graph.run();
+	 * @endcode
+	 */
+	class TaskGraph
+	{
+	public:
+		/**
+		 * @brief Task graph node handle
+		 *
+		 * @tparam RESULT	Result type of the node
+		 */
+		template<typename RESULT>
+		class Node
+		{
+		public:
+			/**
+			 * @brief Get the future of the node result
+			 *
+			 * The result is moved to the future, so the node cannot pass it to any successor. Must be called before
+			 * the graph is run.
+			 *
+			 * @throws <Core::Exception::InvalidTaskGraph>	Future already taken, result passed to successors or graph already run
+			 */
+			Future<RESULT> getFuture( void )
+			{
+				if( this->mState->mHasFuture || ( this->mState->mValueSuccessors > 0 ) || this->mState->mStarted )
+				{
+					BOOST_THROW_EXCEPTION( Exception::InvalidTaskGraph() << Exception::Message( "Node result can be taken only once, before the graph is run." ) );
+				}
+
+				this->mState->mHasFuture = true;
+
+				return( this->mState->mPromise.getFuture() );
+			}
+
+		private:
+			friend class TaskGraph;
+
+			explicit Node( std::shared_ptr<Detail::TaskGraphResultNode<RESULT>> State )
+				:	mState( std::move( State ) )
+			{}
+
+			std::shared_ptr<Detail::TaskGraphResultNode<RESULT>>	mState;
+		};
+
+		/**
+		 * @brief Task graph constructor
+		 *
+		 * @param [in] Pool		Thread pool to run the nodes in
+		 */
+		explicit TaskGraph( ThreadPool & Pool = ThreadPool::get_mutable_instance() )
+			:	mPool( Pool ),
+				mStarted( false )
+		{}
+
+		/**
+		 * @brief Cancellable task graph constructor
+		 *
+		 * Once the token is cancelled, the nodes not started yet are not run. They fail with
+		 * Core::Exception::OperationCancelled instead.
+		 *
+		 * @param [in] Token	Token cancelling the graph
+		 * @param [in] Pool		Thread pool to run the nodes in
+		 */
+		explicit TaskGraph( const CancellationToken & Token, ThreadPool & Pool = ThreadPool::get_mutable_instance() )
+			:	mPool( Pool ),
+				mToken( Token ),
+				mStarted( false )
+		{}
+
+		TaskGraph( const TaskGraph & ) = delete;
+
+		TaskGraph & operator = ( const TaskGraph & ) = delete;
+
+		/**
+		 * @brief Task graph destructor
+		 *
+		 * Graph which was not run is just released.
+		 */
+		~TaskGraph( void )
+		{
+			/* Break the reference cycles between the nodes which were never run */
+			for( std::shared_ptr<Detail::TaskGraphNode> & tNode : this->mNodes )
+			{
+				tNode->mSuccessors.clear();
+			}
+		}
+
+		/**
+		 * @brief Get the token cancelling the graph
+		 *
+		 * The token is meant to be passed to the node functions running for long, so they are able to give up
+		 * once the graph is cancelled.
+		 */
+		const CancellationToken & getCancellationToken( void ) const
+		{
+			return( this->mToken );
+		}
+
+		/**
+		 * @brief Get the thread pool running the nodes
+		 *
+		 * Asynchronous operations started by the nodes are meant to run in the same pool.
+		 */
+		ThreadPool & getPool( void ) const
+		{
+			return( this->mPool );
+		}
+
+		/**
+		 * @brief Add node running the function
+		 *
+		 * @param [in] Function		Function to be called with the results of the predecessors (as lvalue references)
+		 * @param [in] Predecessors	Nodes passing their results to the function
+		 *
+		 * @returns Handle of the node added
+		 *
+		 * @throws <Core::Exception::InvalidTaskGraph>	Graph already run or predecessor's result already taken by future
+		 */
+		template<typename FUNCTION, typename... PREDECESSORS>
+		auto add( FUNCTION && Function, const Node<PREDECESSORS> & ...Predecessors ) -> Node<typename std::invoke_result<typename std::decay<FUNCTION>::type &, PREDECESSORS & ...>::type>
+		{
+			using TResult = typename std::invoke_result<typename std::decay<FUNCTION>::type &, PREDECESSORS & ...>::type;
+			using TNode = Detail::TaskGraphFunctionNode<TResult, typename std::decay<FUNCTION>::type, PREDECESSORS...>;
+
+			return( this->insert<TNode>( std::forward<FUNCTION>( Function ), Predecessors... ) );
+		}
+
+		/**
+		 * @brief Add node running the function which starts asynchronous operation
+		 *
+		 * The Function returns Core::Future of the operation result. The node is finished once the future is ready,
+		 * the result of the future is the result of the node. No worker waits for the operation meanwhile.
+		 *
+		 * @param [in] Function		Function to be called with the results of the predecessors (as lvalue references)
+		 * @param [in] Predecessors	Nodes passing their results to the function
+		 *
+		 * @returns Handle of the node added
+		 *
+		 * @throws <Core::Exception::InvalidTaskGraph>	Graph already run or predecessor's result already taken by future
+		 */
+		template<typename FUNCTION, typename... PREDECESSORS>
+		auto addAsync( FUNCTION && Function, const Node<PREDECESSORS> & ...Predecessors ) -> Node<typename Detail::AsyncNodeResult<typename std::invoke_result<typename std::decay<FUNCTION>::type &, PREDECESSORS & ...>::type>::type>
+		{
+			using TResult = typename Detail::AsyncNodeResult<typename std::invoke_result<typename std::decay<FUNCTION>::type &, PREDECESSORS & ...>::type>::type;
+			using TNode = Detail::TaskGraphAsyncNode<TResult, typename std::decay<FUNCTION>::type, PREDECESSORS...>;
+
+			return( this->insert<TNode>( std::forward<FUNCTION>( Function ), Predecessors... ) );
+		}
+
+		/**
+		 * @brief Add dependency not passing any result
+		 *
+		 * Successor is not run until the predecessor is finished.
+		 *
+		 * @throws <Core::Exception::InvalidTaskGraph>	Graph already run or the dependency would close a cycle
+		 */
+		template<typename PREDECESSOR, typename SUCCESSOR>
+		void addDependency( const Node<PREDECESSOR> & Predecessor, const Node<SUCCESSOR> & Successor )
+		{
+			this->checkNotStarted();
+
+			/* None of the nodes in a cycle would ever become ready */
+			if( isReachable( * Successor.mState, * Predecessor.mState ) )
+			{
+				BOOST_THROW_EXCEPTION( Exception::InvalidTaskGraph() << Exception::Message( "Task graph dependency cannot close a cycle." ) );
+			}
+
+			this->link( * Predecessor.mState, Successor.mState );
+		}
+
+		/**
+		 * @brief Run the graph
+		 *
+		 * Adds all the nodes having no predecessors to the thread pool. Does not wait for anything.
+		 *
+		 * @throws <Core::Exception::InvalidTaskGraph>	Graph already run
+		 */
+		void run( void )
+		{
+			this->checkNotStarted();
+
+			this->mStarted = true;
+
+			for( std::shared_ptr<Detail::TaskGraphNode> & tNode : this->mNodes )
+			{
+				tNode->mStarted = true;
+			}
+
+			/* The roots must be known before any of them is scheduled. Once scheduled, the nodes run and their
+			 * successors become ready, so they would be scheduled twice */
+			std::vector<std::shared_ptr<Detail::TaskGraphNode>> tRoots;
+
+			for( std::shared_ptr<Detail::TaskGraphNode> & tNode : this->mNodes )
+			{
+				if( tNode->mPendingPredecessors == 0 )
+				{
+					tRoots.push_back( std::move( tNode ) );
+				}
+			}
+
+			/* The nodes keep each other alive from now on */
+			this->mNodes.clear();
+
+			for( std::shared_ptr<Detail::TaskGraphNode> & tRoot : tRoots )
+			{
+				Detail::TaskGraphNode::schedule( std::move( tRoot ) );
+			}
+		}
+
+	private:
+		/* Creates the node and links it to its predecessors */
+		template<typename NODE, typename FUNCTION, typename... PREDECESSORS>
+		auto insert( FUNCTION && Function, const Node<PREDECESSORS> & ...Predecessors ) -> Node<typename NODE::ResultType>
+		{
+			this->checkNotStarted();
+
+			for( bool tHasFuture : { false, Predecessors.mState->mHasFuture... } )
+			{
+				if( tHasFuture )
+				{
+					BOOST_THROW_EXCEPTION( Exception::InvalidTaskGraph() << Exception::Message( "Node result already taken by future cannot be passed to successor." ) );
+				}
+			}
+
+			/* Every successor gets its own instance of the result, so the result which cannot be copied has single consumer only */
+			for( bool tShared : { false, ( ( !isCopyable<PREDECESSORS>() ) && ( Predecessors.mState->mValueSuccessors > 0 ) )... } )
+			{
+				if( tShared )
+				{
+					BOOST_THROW_EXCEPTION( Exception::InvalidTaskGraph() << Exception::Message( "Node result which cannot be copied can be passed to single successor only." ) );
+				}
+			}
+
+			std::shared_ptr<NODE> tNode = std::allocate_shared<NODE>( Detail::PoolAllocator<char>(), this->mPool, this->mToken, std::forward<FUNCTION>( Function ), Predecessors.mState... );
+
+			this->mNodes.push_back( tNode );
+
+			for( Detail::TaskGraphNode * tPredecessor : std::initializer_list<Detail::TaskGraphNode *>{ Predecessors.mState.get()... } )
+			{
+				this->link( * tPredecessor, tNode );
+			}
+
+			/* Count the results consumed */
+			for( std::size_t * tValueSuccessors : std::initializer_list<std::size_t *>{ & ( Predecessors.mState->mValueSuccessors )... } )
+			{
+				++( * tValueSuccessors );
+			}
+
+			return( Node<typename NODE::ResultType>( std::move( tNode ) ) );
+		}
+
+		template<typename RESULT>
+		static constexpr bool isCopyable( void )
+		{
+			if constexpr( std::is_void<RESULT>::value )
+			{
+				return( true );
+			}
+			else
+			{
+				return( std::is_copy_constructible<RESULT>::value );
+			}
+		}
+
+		void checkNotStarted( void ) const
+		{
+			if( this->mStarted )
+			{
+				BOOST_THROW_EXCEPTION( Exception::InvalidTaskGraph() << Exception::Message( "Task graph cannot be modified once run." ) );
+			}
+		}
+
+		/* Checks whether the Target is the From node or any of its (indirect) successors */
+		static bool isReachable( Detail::TaskGraphNode & From, Detail::TaskGraphNode & Target )
+		{
+			std::vector<Detail::TaskGraphNode *> tPending{ & From };
+			std::unordered_set<Detail::TaskGraphNode *> tVisited;
+
+			while( !tPending.empty() )
+			{
+				Detail::TaskGraphNode * tNode = tPending.back();
+				tPending.pop_back();
+
+				if( tNode == & Target )
+				{
+					return( true );
+				}
+
+				if( tVisited.insert( tNode ).second )
+				{
+					for( const std::shared_ptr<Detail::TaskGraphNode> & tSuccessor : tNode->mSuccessors )
+					{
+						tPending.push_back( tSuccessor.get() );
+					}
+				}
+			}
+
+			return( false );
+		}
+
+		static void link( Detail::TaskGraphNode & Predecessor, const std::shared_ptr<Detail::TaskGraphNode> & Successor )
+		{
+			Predecessor.mSuccessors.push_back( Successor );
+			++( Successor->mPendingPredecessors );
+		}
+
+		ThreadPool &		mPool;
+
+		CancellationToken	mToken;
+
+		bool				mStarted;
+
+		/* All the nodes of the graph not run yet */
+		std::vector<std::shared_ptr<Detail::TaskGraphNode>>	mNodes;
+	};
+}
+
+#endif /* CORE_THREADPOOL_TASKGRAPH_H_ */
@@ -1,123 +1,1302 @@
-
 /* Standard library inclusions */
 #include <iterator>
 #include <algorithm>
 
 #include <iostream>
+#include <cstdlib>
+#include <string>
+#include <map>
 
 /* Project specific inclusions */
 #include "ThreadPool/ThreadPool.h"
 
 using namespace Core;
 
-CORE_EXPORT ThreadPool::ThreadPool( void )
-#if false
-	:	ThreadCount( std::thread::hardware_concurrency() ),
+namespace
+{
+	// identifies the pool and the worker queue owned by the calling thread (if it is a pool worker at all)
+	struct WorkerContext
+	{
+		ThreadPool* pool;
+		std::size_t index;
+
+		// priority of the job being run by the worker
+		ThreadPool::Priority priority;
+
+		// number of jobs being run by the worker, the nested ones are run while the outer ones wait
+		std::size_t depth;
+	};
+
+	thread_local WorkerContext currentWorker{ nullptr, 0, ThreadPool::Priority::Normal, 0 };
+
+	// node the jobs added by the calling thread are queued on, see ThreadPool::NodeHint
+	thread_local std::size_t currentNodeHint = ThreadPool::AnyNode;
+
+	// environment variable overriding the default number of worker threads
+	const char* const ThreadCountVariable = "CORE_THREADPOOL_SIZE";
+
+	// environment variable starting the periodic statistics dump, set to the period in milliseconds
+	const char* const StatisticsVariable = "CORE_THREADPOOL_STATISTICS";
+
+	// environment variable setting the initial affinity of the workers
+	const char* const AffinityVariable = "CORE_THREADPOOL_AFFINITY";
+
+	std::uint64_t nanoseconds(std::chrono::steady_clock::duration duration)
+	{
+		return static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), 0));
+	}
+
+	// environment variable choosing the queues of the singleton
+	const char* const QueueVariable = "CORE_THREADPOOL_QUEUE";
+
+	// environment variable setting the initial execution mode of the pools
+	const char* const ModeVariable = "CORE_THREADPOOL_MODE";
+
+	// number of attempts of an idle worker of the lock-free pool to find a job before going to sleep
+	const std::size_t SpinCount = 4096;
+
+	// lets the sibling hyper-thread run while spinning
+	void cpuRelax()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
 #else
-	:	ThreadCount( 6 ),
+		std::this_thread::yield();
 #endif
+	}
+
+	ThreadPool::QueueType defaultQueueType()
+	{
+		const char* variable = std::getenv( QueueVariable );
+
+		if(variable == nullptr)
+			return ThreadPool::QueueType::WorkStealing;
+
+		std::string value( variable );
+
+		if(value == "lockfree")
+			return ThreadPool::QueueType::LockFree;
+
+		if(value != "workstealing")
+			std::cout << "ThreadPool: Ignoring invalid " << QueueVariable << " value '" << value << "'." << std::endl;
+
+		return ThreadPool::QueueType::WorkStealing;
+	}
+
+	ThreadPool::ExecutionMode defaultExecutionMode()
+	{
+		const char* variable = std::getenv( ModeVariable );
+
+		if(variable == nullptr)
+			return ThreadPool::ExecutionMode::Parallel;
+
+		std::string value( variable );
+
+		if(value == "serial")
+			return ThreadPool::ExecutionMode::Serial;
+
+		if(value != "parallel")
+			std::cout << "ThreadPool: Ignoring invalid " << ModeVariable << " value '" << value << "'." << std::endl;
+
+		return ThreadPool::ExecutionMode::Parallel;
+	}
+
+	// upper limit of the worker threads of any pool
+	std::size_t maxThreadCount()
+	{
+		return std::max<std::size_t>(4 * std::thread::hardware_concurrency(), 256);
+	}
+
+	// pools created by ThreadPool::create(), guarded by registryMutex
+	std::mutex registryMutex;
+	std::map<std::string, std::unique_ptr<ThreadPool>> registry;
+
+	// counts the thread queueing a job in until the job is queued, see ThreadPool::shutdown()
+	struct EnqueueScope
+	{
+		explicit EnqueueScope(std::atomic<std::size_t>& producers)
+			:	producers(producers)
+		{
+			++producers;
+		}
+
+		~EnqueueScope()
+		{
+			--producers;
+		}
+
+		std::atomic<std::size_t>& producers;
+	};
+
+	// orders the delayed jobs heap so the earliest deadline is on the top
+	template<typename DELAYED_JOB>
+	bool isLater(const DELAYED_JOB& first, const DELAYED_JOB& second)
+	{
+		return first.deadline > second.deadline;
+	}
+}
+
+CORE_EXPORT const char* const ThreadPool::DefaultName = "default";
+
+CORE_EXPORT ThreadPool::ThreadPool( void )
+	:	ThreadPool( DefaultName, std::min( defaultThreadCount(), maxThreadCount() ), defaultQueueType() )
+{}
+
+CORE_EXPORT ThreadPool::ThreadPool( std::string name, std::size_t count, QueueType queue )
+	:	MaxThreadCount( maxThreadCount() ),
+		poolName( std::move( name ) ),
+		jobQueue( queue ),
+		cpuTopology( CpuTopology::detect() ),
+		workers( std::make_unique<std::unique_ptr<Worker>[]>( MaxThreadCount ) ),
+		workerAffinity( Affinity::None ),
+		activeWorkers(0),
+		usedWorkers(0),
+		jobExecution(defaultExecutionMode()),
+		parallelThreadCount(0),
+		serialBacklog(false),
+		becomingSerial(false),
+		pendingJobs(0),
+		unfinishedJobs(0),
+		nextQueue(0),
 		threadsWaiting(0),
+		statisticsStart(std::chrono::steady_clock::now().time_since_epoch().count()),
+		dumpPeriod(std::chrono::steady_clock::duration::zero()),
 		terminate(false),
-		paused(false)
+		paused(false),
+		shuttingDown(false),
+		stopped(false),
+		producers(0),
+		failedJobs(0),
+		cancelledJobs(0)
 {
-	std::cout << "Starting ThreadPool running " << ThreadCount << " worker threads." << std::endl;
+	if(jobQueue == QueueType::LockFree)
+	{
+		for(auto& lane : sharedJobs)
+			lane = std::make_unique<Detail::MpmcQueue<Job>>( SharedQueueCapacity );
+	}
+
+	const char* variable = std::getenv( AffinityVariable );
+
+	if(variable != nullptr)
+	{
+		std::string value( variable );
+
+		if(value == "core")
+			workerAffinity = Affinity::Core;
+		else if(value == "node")
+			workerAffinity = Affinity::Node;
+		else if(value != "none")
+			std::cout << "ThreadPool: Ignoring invalid " << AffinityVariable << " value '" << value << "'." << std::endl;
+	}
+
+	std::cout << "Starting ThreadPool '" << poolName << "' running " << count << " worker threads on " << cpuTopology.getNodeCount() << " NUMA nodes." << std::endl;
 
-	// prevent potential reallocation, thereby screwing up all our hopes and dreams
-	threads.reserve( ThreadCount );
-	std::generate_n(std::back_inserter(threads), ThreadCount, [this]() { return std::thread{threadTask, this}; });
+	if(jobExecution == ExecutionMode::Serial)
+		std::cout << "ThreadPool '" << poolName << "' runs the jobs serially on single worker thread." << std::endl;
+
+	resize( count );
+
+	variable = std::getenv( StatisticsVariable );
+
+	if(variable != nullptr)
+	{
+		char* end = nullptr;
+		unsigned long period = std::strtoul( variable, &end, 10 );
+
+		if((end != variable) && (*end == '\0'))
+			dumpStatistics( std::chrono::milliseconds( period ) );
+		else
+			std::cout << "ThreadPool: Ignoring invalid " << StatisticsVariable << " value '" << variable << "'." << std::endl;
+	}
 }
 
 CORE_EXPORT ThreadPool::~ThreadPool()
 {
-	clear();
+	// the worker cannot join itself and it would be left running the freed pool. The exception thrown by
+	// shutdown() would not get out of the destructor anyway, so fail right away telling why
+	if(currentWorker.pool == this)
+	{
+		std::cout << "ThreadPool '" << poolName << "' cannot be destroyed by its own worker." << std::endl;
+		std::terminate();
+	}
+
+	shutdown(false);
+
+	// nothing starts the timer once the pool is terminating, but the pool may have been shut down before
+	if(timer.joinable())
+		timer.join();
+}
+
+CORE_EXPORT ThreadPool::ShutdownReport ThreadPool::shutdown(bool drain, std::chrono::steady_clock::time_point deadline)
+{
+	if(currentWorker.pool == this)
+	{
+		BOOST_THROW_EXCEPTION( Exception::InvalidThreadPoolOperation() << Exception::Message( "ThreadPool worker cannot shut its own pool down." ) );
+	}
+
+	std::lock_guard<std::mutex> shutdownLock{shutdownMutex};
+
+	ShutdownReport report{ true, 0 };
+
+	if(stopped)
+		return report;
+
+	shuttingDown = true;
+
+	if(drain)
+	{
+		// paused pool would never drain
+		pause(false);
+		flushDelayed();
+
+		report.drained = waitUntil(deadline);
+	}
+
+	report.droppedJobs = dropJobs();
 
 	// tell threads to stop when they can
-	terminate = true;
+	{
+		std::lock_guard<std::mutex> idleLock{idleMutex};
+		terminate = true;
+	}
 	jobsAvailable.notify_all();
 
+	{
+		std::lock_guard<std::mutex> timerLock{timerMutex};
+	}
+	timerChanged.notify_all();
+
+	if(timer.joinable())
+		timer.join();
+
 	// wait for all threads to finish
-	for(auto& t : threads)
+	for(std::size_t index = 0; index < usedWorkers; ++index)
 	{
-		if(t.joinable())
-			t.join();
+		if(workers[index]->thread.joinable())
+			workers[index]->thread.join();
 	}
+
+	stopped = true;
+
+	// the producers which got past checkRunning() before the pool stopped get their jobs queued first,
+	// so none is left in the queues once they are dropped
+	while(producers > 0)
+		std::this_thread::yield();
+
+	// jobs added by the jobs finished meanwhile are never run
+	report.droppedJobs += dropJobs();
+	report.drained = report.drained && (report.droppedJobs == 0);
+
+	if(report.droppedJobs > 0)
+		std::cout << "ThreadPool '" << poolName << "': " << report.droppedJobs << " jobs dropped at shutdown." << std::endl;
+
+	return report;
 }
 
-CORE_EXPORT std::size_t ThreadPool::threadCount() const
+CORE_EXPORT bool ThreadPool::isShuttingDown() const
 {
-	return threads.size();
+	return shuttingDown;
 }
 
-CORE_EXPORT std::size_t ThreadPool::waitingJobs() const
+CORE_EXPORT bool ThreadPool::isStopped() const
 {
-	std::lock_guard<std::mutex> jobLock(jobsMutex);
-	return jobs.size();
+	return stopped;
 }
 
-CORE_EXPORT ThreadPool::Ids ThreadPool::ids() const
+CORE_EXPORT void ThreadPool::checkRunning() const
+{
+	if(stopped)
+	{
+		BOOST_THROW_EXCEPTION( Exception::InvalidThreadPoolOperation() << Exception::Message( "ThreadPool '" + poolName + "' is shut down." ) );
+	}
+}
+
+CORE_EXPORT ThreadPool& ThreadPool::create(const std::string& name, std::size_t count, QueueType queue)
 {
-	Ids ret(threads.size());
+	std::lock_guard<std::mutex> registryLock{registryMutex};
+
+	if((name == DefaultName) || (registry.count(name) > 0))
+	{
+		BOOST_THROW_EXCEPTION( Exception::InvalidThreadPoolOperation() << Exception::Message( "ThreadPool '" + name + "' exists already." ) );
+	}
 
-	std::transform(threads.begin(), threads.end(), ret.begin(), [](const std::thread& t) { return t.get_id(); });
+	auto& pool = registry[name];
 
-	return ret;
+	try
+	{
+		pool = std::make_unique<ThreadPool>(name, count, queue);
+	}
+	catch(...)
+	{
+		registry.erase(name);
+		throw;
+	}
+
+	return *pool;
 }
 
-CORE_EXPORT void ThreadPool::clear()
+CORE_EXPORT ThreadPool& ThreadPool::instance(const std::string& name)
 {
-	std::lock_guard<std::mutex> lock{jobsMutex};
+	if(name == DefaultName)
+		return get_mutable_instance();
+
+	std::lock_guard<std::mutex> registryLock{registryMutex};
+
+	auto found = registry.find(name);
+
+	if(found == registry.end())
+	{
+		BOOST_THROW_EXCEPTION( Exception::InvalidThreadPoolOperation() << Exception::Message( "ThreadPool '" + name + "' does not exist." ) );
+	}
 
-	while(!jobs.empty())
-		jobs.pop();
+	return *found->second;
 }
 
-CORE_EXPORT void ThreadPool::pause(bool state)
+CORE_EXPORT bool ThreadPool::destroy(const std::string& name)
 {
-	paused = state;
+	std::unique_ptr<ThreadPool> pool;
 
-	if(!paused)
+	{
+		std::lock_guard<std::mutex> registryLock{registryMutex};
+
+		auto found = registry.find(name);
+
+		if(found == registry.end())
+			return false;
+
+		if(currentWorker.pool == found->second.get())
+		{
+			BOOST_THROW_EXCEPTION( Exception::InvalidThreadPoolOperation() << Exception::Message( "ThreadPool worker cannot destroy its own pool." ) );
+		}
+
+		pool = std::move(found->second);
+		registry.erase(found);
+	}
+
+	// the workers are joined without holding the registry, their jobs may look up the other pools
+	pool.reset();
+
+	return true;
+}
+
+CORE_EXPORT const std::string& ThreadPool::name() const
+{
+	return poolName;
+}
+
+CORE_EXPORT std::size_t ThreadPool::threadCount() const
+{
+	return activeWorkers;
+}
+
+CORE_EXPORT std::size_t ThreadPool::defaultThreadCount()
+{
+	const char* variable = std::getenv( ThreadCountVariable );
+
+	if(variable != nullptr)
+	{
+		char* end = nullptr;
+		unsigned long count = std::strtoul( variable, &end, 10 );
+
+		if((end != variable) && (*end == '\0') && (count > 0))
+			return count;
+
+		std::cout << "ThreadPool: Ignoring invalid " << ThreadCountVariable << " value '" << variable << "'." << std::endl;
+	}
+
+	// hardware_concurrency() may return 0 if the value is not computable
+	return std::max( std::thread::hardware_concurrency(), 1u );
+}
+
+CORE_EXPORT void ThreadPool::resize(std::size_t count)
+{
+	if((count == 0) || (count > MaxThreadCount))
+	{
+		BOOST_THROW_EXCEPTION( Exception::InvalidThreadCount() << Exception::Message( "ThreadPool must run 1 to " + std::to_string( MaxThreadCount ) + " worker threads." ) );
+	}
+
+	std::lock_guard<std::mutex> resizeLock{resizeMutex};
+
+	resizeWorkers(count);
+}
+
+CORE_EXPORT void ThreadPool::resizeWorkers(std::size_t count)
+{
+	// the serial pool keeps single worker, the count is restored once switched back to parallel
+	parallelThreadCount = count;
+
+	if(jobExecution == ExecutionMode::Serial)
+		count = 1;
+
+	std::size_t active = activeWorkers;
+
+	if(count > active)
+	{
+		for(std::size_t index = active; index < count; ++index)
+			startWorker(index);
+
+		activeWorkers = count;
+	}
+	else if(count < active)
+	{
+		if((currentWorker.pool == this) && (currentWorker.index >= count))
+		{
+			BOOST_THROW_EXCEPTION( Exception::InvalidThreadPoolOperation() << Exception::Message( "ThreadPool worker cannot retire itself." ) );
+		}
+
+		// new jobs are not distributed to the retiring workers any more
+		activeWorkers = count;
+
+		{
+			std::lock_guard<std::mutex> idleLock{idleMutex};
+
+			for(std::size_t index = count; index < active; ++index)
+				workers[index]->retire = true;
+		}
 		jobsAvailable.notify_all();
+
+		// jobs left in the queues of the retired workers are stolen by the remaining ones
+		for(std::size_t index = count; index < active; ++index)
+			workers[index]->thread.join();
+	}
 }
 
-CORE_EXPORT void ThreadPool::wait()
+CORE_EXPORT void ThreadPool::startWorker(std::size_t index)
 {
-	// we're done waiting once all threads are waiting
-	while(threadsWaiting != threads.size());
+	if(index == usedWorkers)
+	{
+		// the slot becomes visible to the thieves once it is fully constructed
+		workers[index] = std::make_unique<Worker>();
+		usedWorkers = index + 1;
+	}
+
+	workers[index]->retire = false;
+	workers[index]->thread = std::thread{threadTask, this, index};
+
+	pinWorker(index);
 }
 
-CORE_EXPORT void ThreadPool::threadTask(ThreadPool* pool)
+CORE_EXPORT void ThreadPool::pinWorker(std::size_t index)
 {
-	// loop until we break (to keep thread alive)
-	while(true)
+	std::size_t nodes = cpuTopology.getNodeCount();
+	std::size_t node = index % nodes;
+
+	CpuTopology::TCpus cpus;
+
+	switch(workerAffinity.load())
 	{
-		// if we need to finish, let's do it before we get into
-		// all the expensive synchronization stuff
-		if(pool->terminate)
-			break;
+	case Affinity::None:
+		// unpinned worker may run on any CPU of any node
+		for(std::size_t current = 0; current < nodes; ++current)
+			cpus.insert(cpus.end(), cpuTopology.getCpus(current).begin(), cpuTopology.getCpus(current).end());
+		break;
 
-		std::unique_lock<std::mutex> jobsLock{pool->jobsMutex};
+	case Affinity::Core:
+		// the workers of the node take its CPUs in turn
+		cpus.push_back(cpuTopology.getCpus(node)[(index / nodes) % cpuTopology.getCpus(node).size()]);
+		break;
 
-		// if there are no more jobs, or we're paused, go into waiting mode
-		if(pool->jobs.empty() || pool->paused)
+	case Affinity::Node:
+		cpus = cpuTopology.getCpus(node);
+		break;
+	}
+
+	// unpinning is not worth the message on the platforms not supporting the affinity at all
+	if(!CpuTopology::setAffinity(workers[index]->thread, cpus) && (workerAffinity != Affinity::None))
+		std::cout << "ThreadPool: Cannot set the affinity of worker " << index << "." << std::endl;
+}
+
+CORE_EXPORT void ThreadPool::setAffinity(Affinity affinity)
+{
+	std::lock_guard<std::mutex> resizeLock{resizeMutex};
+
+	workerAffinity = affinity;
+
+	for(std::size_t index = 0; index < activeWorkers; ++index)
+		pinWorker(index);
+}
+
+CORE_EXPORT ThreadPool::Affinity ThreadPool::affinity() const
+{
+	return workerAffinity;
+}
+
+CORE_EXPORT const CpuTopology& ThreadPool::topology() const
+{
+	return cpuTopology;
+}
+
+CORE_EXPORT std::size_t ThreadPool::currentNode() const
+{
+	if((currentWorker.pool == this) && (workerAffinity != Affinity::None))
+		return currentWorker.index % cpuTopology.getNodeCount();
+
+	std::size_t cpu = CpuTopology::getCurrentCpu();
+
+	return (cpu != CpuTopology::UnknownCpu) ? cpuTopology.getNode(cpu) : 0;
+}
+
+CORE_EXPORT std::size_t ThreadPool::placementNodes() const
+{
+	return (workerAffinity != Affinity::None) ? cpuTopology.getNodeCount() : 1;
+}
+
+CORE_EXPORT ThreadPool::NodeHint::NodeHint(std::size_t node)
+	:	previous(currentNodeHint)
+{
+	currentNodeHint = node;
+}
+
+CORE_EXPORT ThreadPool::NodeHint::~NodeHint()
+{
+	currentNodeHint = previous;
+}
+
+CORE_EXPORT void ThreadPool::setExecutionMode(ExecutionMode mode)
+{
+	std::lock_guard<std::mutex> resizeLock{resizeMutex};
+
+	if(mode == jobExecution)
+		return;
+
+	if(mode == ExecutionMode::Serial)
+	{
+		// new jobs go to the serial queue from now on. The workers take no job until the ones queued already are
+		// moved in front of them, so the serial pool runs all the jobs in the order they were added
+		becomingSerial = true;
+		jobExecution = mode;
+
+		resizeWorkers(activeWorkers);
+
+		std::vector<Job> queued;
+
+		for(std::size_t lane = 0; lane < PriorityCount; ++lane)
 		{
-			++pool->threadsWaiting;
-			pool->jobsAvailable.wait(jobsLock, [&]()
+			if(sharedJobs[lane])
 			{
-				return pool->terminate || !(pool->jobs.empty() || pool->paused);
-			});
-			--pool->threadsWaiting;
-		}
+				for(Job job; sharedJobs[lane]->tryPop(job); job = Job())
+					queued.push_back(std::move(job));
+			}
 
-		// check once more before grabbing a job, since we want to stop ASAP
-		if(pool->terminate)
-			break;
+			for(std::size_t index = 0; index < usedWorkers; ++index)
+				workers[index]->jobs[lane].takeAll(queued);
+		}
 
-		// take next job
-		auto job = std::move(pool->jobs.front());
-		pool->jobs.pop();
+		// every queue keeps its jobs in the order they were added, the queues are merged by the time the jobs were
+		std::stable_sort(queued.begin(), queued.end(), [](const Job& first, const Job& second) { return first.queued < second.queued; });
 
-		jobsLock.unlock();
+		serialJobs.pushFront(queued.begin(), queued.end());
 
-		job();
+		becomingSerial = false;
+		return;
 	}
+
+	jobExecution = mode;
+
+	// the jobs left in the serial queue stay there, the workers take them first (oldest first) until it is empty
+	serialBacklog = (serialJobs.size() > 0);
+
+	resizeWorkers(parallelThreadCount);
+}
+
+CORE_EXPORT ThreadPool::ExecutionMode ThreadPool::executionMode() const
+{
+	return jobExecution;
+}
+
+CORE_EXPORT ThreadPool::QueueType ThreadPool::queueType() const
+{
+	return jobQueue;
+}
+
+CORE_EXPORT std::size_t ThreadPool::waitingJobs() const
+{
+	return pendingJobs;
+}
+
+CORE_EXPORT ThreadPool::Ids ThreadPool::ids() const
+{
+	std::lock_guard<std::mutex> resizeLock{resizeMutex};
+
+	Ids ret(activeWorkers);
+
+	std::transform(workers.get(), workers.get() + ret.size(), ret.begin(), [](const std::unique_ptr<Worker>& w) { return w->thread.get_id(); });
+
+	return ret;
+}
+
+CORE_EXPORT void ThreadPool::clear()
+{
+	dropJobs();
+}
+
+CORE_EXPORT std::size_t ThreadPool::flushDelayed()
+{
+	std::vector<DelayedJob> due;
+
+	{
+		std::lock_guard<std::mutex> timerLock{timerMutex};
+
+		due.swap(delayedJobs);
+	}
+
+	// the jobs are queued (counted unfinished once more) before they stop being counted as delayed
+	for(auto& job : due)
+	{
+		NodeHint hint(job.node);
+
+		enqueue(std::move(job.job), job.priority);
+	}
+
+	finishJobs(due.size());
+
+	return due.size();
+}
+
+CORE_EXPORT std::size_t ThreadPool::dropJobs()
+{
+	std::size_t dropped = serialJobs.clear();
+
+	for(auto& lane : sharedJobs)
+	{
+		if(lane)
+			dropped += lane->clear();
+	}
+
+	for(std::size_t index = 0; index < usedWorkers; ++index)
+	{
+		for(auto& lane : workers[index]->jobs)
+			dropped += lane.clear();
+	}
+
+	pendingJobs -= dropped;
+
+	// delayed jobs are not pending, but they are unfinished
+	{
+		std::lock_guard<std::mutex> timerLock{timerMutex};
+
+		dropped += delayedJobs.size();
+		delayedJobs.clear();
+	}
+
+	// dropped jobs will never finish, release the waiting threads if there is nothing else to wait for
+	finishJobs(dropped);
+
+	return dropped;
+}
+
+CORE_EXPORT void ThreadPool::pause(bool state)
+{
+	paused = state;
+
+	if(!paused)
+	{
+		// synchronize with workers going to sleep so none of them misses the notification
+		{
+			std::lock_guard<std::mutex> idleLock{idleMutex};
+		}
+		jobsAvailable.notify_all();
+	}
+}
+
+CORE_EXPORT void ThreadPool::wait()
+{
+	waitUntil(std::chrono::steady_clock::time_point::max());
+}
+
+CORE_EXPORT bool ThreadPool::waitUntil(std::chrono::steady_clock::time_point deadline)
+{
+	if(currentWorker.pool == this)
+	{
+		BOOST_THROW_EXCEPTION( Exception::InvalidThreadPoolOperation() << Exception::Message( "ThreadPool worker cannot wait for its own job to be finished." ) );
+	}
+
+	std::unique_lock<std::mutex> finishedLock{finishedMutex};
+
+	auto finished = [this]() { return unfinishedJobs == 0; };
+
+	// waiting until time_point::max() would overflow inside of the condition variable
+	if(deadline == std::chrono::steady_clock::time_point::max())
+	{
+		jobsFinished.wait(finishedLock, finished);
+
+		return true;
+	}
+
+	return jobsFinished.wait_until(finishedLock, deadline, finished);
+}
+
+template<typename ITERATOR>
+void ThreadPool::pushSerial(ITERATOR first, ITERATOR last)
+{
+	serialJobs.push(first, last);
+
+	if(jobExecution != ExecutionMode::Serial)
+		serialBacklog = true;
+}
+
+CORE_EXPORT void ThreadPool::enqueue(Job&& job, Priority priority)
+{
+	// counted in before the check, so shutdown() does not drop the jobs until this one is queued
+	EnqueueScope scope{producers};
+
+	checkRunning();
+
+	// count the job first, a worker which takes it decrements the counter
+	++unfinishedJobs;
+	++pendingJobs;
+
+	job.queued = std::chrono::steady_clock::now();
+
+	std::size_t lane = static_cast<std::size_t>(priority);
+
+	// the serial pool takes the jobs in the order they were added, whatever their priority is. Otherwise
+	// the shared lane takes the job unless it is full, the job overflows to a worker's queue then
+	if(jobExecution == ExecutionMode::Serial)
+		pushSerial(&job, &job + 1);
+	else if(!sharedJobs[lane] || !sharedJobs[lane]->tryPush(std::move(job)))
+		workers[queueIndex()]->jobs[lane].push(std::move(job));
+
+	// let a waiting thread know there is an available job. The lock ensures the notification cannot
+	// get lost between the worker's check for pending jobs and its going to sleep.
+	if(threadsWaiting > 0)
+	{
+		{
+			std::lock_guard<std::mutex> idleLock{idleMutex};
+		}
+		jobsAvailable.notify_one();
+	}
+}
+
+CORE_EXPORT void ThreadPool::enqueueAt(Job&& job, Priority priority, std::chrono::steady_clock::time_point deadline)
+{
+	// the pool being shut down does not wait for anything
+	if(shuttingDown)
+	{
+		enqueue(std::move(job), priority);
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> timerLock{timerMutex};
+
+		// the pool started terminating meanwhile, its timer is stopped (or about to be), see shutdown()
+		if(terminate)
+		{
+			timerLock.unlock();
+
+			enqueue(std::move(job), priority);
+			return;
+		}
+
+		// the job is unfinished from now on, so wait() does not miss it
+		++unfinishedJobs;
+
+		delayedJobs.push_back(DelayedJob{ deadline, std::move(job), priority, currentNodeHint });
+		std::push_heap(delayedJobs.begin(), delayedJobs.end(), isLater<DelayedJob>);
+
+		if(!timer.joinable())
+			timer = std::thread{timerTask, this};
+	}
+
+	// the timer may need to wake up earlier than it planned
+	timerChanged.notify_one();
+}
+
+CORE_EXPORT void ThreadPool::enqueueBatch(std::vector<Job>& jobs, Priority priority)
+{
+	if(jobs.empty())
+		return;
+
+	EnqueueScope scope{producers};
+
+	checkRunning();
+
+	unfinishedJobs += jobs.size();
+	pendingJobs += jobs.size();
+
+	std::chrono::steady_clock::time_point queued = std::chrono::steady_clock::now();
+
+	for(auto& job : jobs)
+		job.queued = queued;
+
+	std::size_t lane = static_cast<std::size_t>(priority);
+	auto first = jobs.begin();
+
+	if(jobExecution == ExecutionMode::Serial)
+	{
+		pushSerial(first, jobs.end());
+		first = jobs.end();
+	}
+	else if(sharedJobs[lane])
+	{
+		while((first != jobs.end()) && sharedJobs[lane]->tryPush(std::move(*first)))
+			++first;
+	}
+
+	// the whole batch (or the rest not fitting the shared lane) goes to single queue, the idle workers steal from it
+	if(first != jobs.end())
+		workers[queueIndex()]->jobs[lane].push(first, jobs.end());
+
+	// single notification for the whole batch
+	if(threadsWaiting > 0)
+	{
+		{
+			std::lock_guard<std::mutex> idleLock{idleMutex};
+		}
+
+		if(jobs.size() > 1)
+			jobsAvailable.notify_all();
+		else
+			jobsAvailable.notify_one();
+	}
+}
+
+CORE_EXPORT std::size_t ThreadPool::queueIndex()
+{
+	std::size_t nodes = placementNodes();
+	std::size_t node = currentNodeHint;
+	std::size_t active = activeWorkers;
+
+	// hint to a node not known (or not having any worker running) is ignored
+	if((nodes == 1) || (node >= std::min(nodes, active)))
+		node = AnyNode;
+
+	// nested submissions stay on the submitting worker, unless hinted to another node
+	if((currentWorker.pool == this) && ((node == AnyNode) || ((currentWorker.index % nodes) == node)))
+		return currentWorker.index;
+
+	// the others are spread among all the workers, or among the workers of the hinted node
+	if(node == AnyNode)
+		return nextQueue++ % active;
+
+	return node + nodes * (nextQueue++ % ((active - node + nodes - 1) / nodes));
+}
+
+CORE_EXPORT std::size_t ThreadPool::grainSize(std::size_t count) const
+{
+	// few chunks per worker balance the load without flooding the queues
+	std::size_t chunks = 4 * activeWorkers;
+
+	return std::max<std::size_t>((count + chunks - 1) / chunks, 1);
+}
+
+CORE_EXPORT ThreadPool::Priority ThreadPool::currentPriority() const
+{
+	return (currentWorker.pool == this) ? currentWorker.priority : Priority::Normal;
+}
+
+CORE_EXPORT bool ThreadPool::findJob(std::size_t index, Job& job, Priority& priority)
+{
+	if(paused)
+		return false;
+
+	// the jobs queued before the pool becomes serial are being moved to the serial queue, see setExecutionMode()
+	if(becomingSerial)
+		return false;
+
+	Worker& worker = *workers[index];
+
+	// the serial pool runs the oldest job first. Once parallel again, the jobs left by the serial pool are
+	// taken first the same way
+	if((jobExecution == ExecutionMode::Serial) || serialBacklog)
+	{
+		if(serialJobs.steal(job))
+		{
+			worker.queueDepth.record(pendingJobs--);
+			priority = Priority::Normal;
+
+			return true;
+		}
+
+		// the steal fails once the queue is busy as well. The serial pool tries again rather than letting the
+		// other queues overtake the serial one, they just hold the jobs of the producers which saw the pool
+		// parallel yet
+		if(jobExecution == ExecutionMode::Serial)
+		{
+			if(serialJobs.size() > 0)
+				return false;
+		}
+		// the backlog is done only once it is empty. The queue is checked again after clearing the flag,
+		// a job might have been pushed meanwhile
+		else if(serialJobs.size() == 0)
+		{
+			serialBacklog = false;
+
+			if(serialJobs.size() > 0)
+				serialBacklog = true;
+		}
+	}
+
+	// higher priority lanes are served first most of the time. Every 4th job the normal lane
+	// is served first and every 16th job the background one, so no lane starves
+	std::size_t tick = worker.ticks++;
+	std::size_t first = ((tick % 16) == 15) ? 2 : (((tick % 4) == 3) ? 1 : 0);
+
+	std::size_t used = usedWorkers;
+	std::size_t nodes = placementNodes();
+
+	for(std::size_t lane = 0; lane < PriorityCount; ++lane)
+	{
+		// the preferred lane first, then the others in the order of priority
+		std::size_t current = (lane == 0) ? first : ((lane <= first) ? (lane - 1) : lane);
+
+		// shared queue first (FIFO), then own queue (LIFO)...
+		bool found = (sharedJobs[current] && sharedJobs[current]->tryPop(job)) || worker.jobs[current].pop(job);
+
+		// ...then try to steal the oldest job of the other workers (FIFO), including the retired ones. The workers
+		// of the same node are robbed first, the remote ones only if there is nothing to be done locally
+		for(std::size_t pass = 0; (!found) && (pass < std::min<std::size_t>(nodes, 2)); ++pass)
+		{
+			for(std::size_t offset = 1; (!found) && (offset < used); ++offset)
+			{
+				std::size_t victim = (index + offset) % used;
+
+				if((nodes == 1) || (((victim % nodes) == (index % nodes)) == (pass == 0)))
+					found = workers[victim]->jobs[current].steal(job);
+			}
+		}
+
+		if(found)
+		{
+			// depth of the queues the job waited in
+			worker.queueDepth.record(pendingJobs--);
+			priority = static_cast<Priority>(current);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+CORE_EXPORT void ThreadPool::runJob(Job& job, Priority priority)
+{
+	// jobs added by the job inherit its priority
+	Priority previous = currentWorker.priority;
+
+	Worker& worker = *workers[currentWorker.index];
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	worker.waitTime.record(nanoseconds(start - job.queued));
+
+	currentWorker.priority = priority;
+	++currentWorker.depth;
+	job.task();
+	--currentWorker.depth;
+	currentWorker.priority = previous;
+
+	std::uint64_t run = nanoseconds(std::chrono::steady_clock::now() - start);
+
+	worker.runTime.record(run);
+	worker.jobsRun.store(worker.jobsRun.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	// nested jobs run while the outer one waits are already part of its run time
+	if(currentWorker.depth == 0)
+		worker.busyTime.store(worker.busyTime.load(std::memory_order_relaxed) + run, std::memory_order_relaxed);
+
+	finishJobs(1);
+}
+
+CORE_EXPORT bool ThreadPool::spinForJob(std::size_t index, Job& job, Priority& priority)
+{
+	Worker& worker = *workers[index];
+
+	for(std::size_t spin = 0; spin < SpinCount; ++spin)
+	{
+		if(terminate || worker.retire)
+			return false;
+
+		if((pendingJobs > 0) && findJob(index, job, priority))
+			return true;
+
+		// do not hold the CPU another thread (perhaps the one adding the jobs) could use
+		if((spin % 64) == 63)
+			std::this_thread::yield();
+		else
+			cpuRelax();
+	}
+
+	return false;
+}
+
+CORE_EXPORT void ThreadPool::finishJobs(std::size_t count)
+{
+	// the last job finished releases the threads waiting for all the jobs
+	if((count > 0) && ((unfinishedJobs -= count) == 0))
+	{
+		{
+			std::lock_guard<std::mutex> finishedLock{finishedMutex};
+		}
+		jobsFinished.notify_all();
+	}
+}
+
+CORE_EXPORT bool ThreadPool::isWorker() const
+{
+	return currentWorker.pool == this;
+}
+
+CORE_EXPORT bool ThreadPool::runPendingJob()
+{
+	// only pool workers help, any other thread just blocks
+	if(currentWorker.pool != this)
+		return false;
+
+	Job job;
+	Priority priority;
+
+	if(!findJob(currentWorker.index, job, priority))
+		return false;
+
+	runJob(job, priority);
+
+	return true;
+}
+
+CORE_EXPORT void ThreadPool::threadTask(ThreadPool* pool, std::size_t index)
+{
+	currentWorker = WorkerContext{ pool, index, Priority::Normal, 0 };
+
+	Worker& worker = *pool->workers[index];
+
+	// loop until we break (to keep thread alive)
+	while(true)
+	{
+		// if we need to finish, let's do it before we get into
+		// all the expensive synchronization stuff
+		if(pool->terminate || worker.retire)
+			break;
+
+		Job job;
+		Priority priority;
+
+		// run any job available without touching the shared idle lock
+		if(pool->findJob(index, job, priority))
+		{
+			pool->runJob(job, priority);
+			continue;
+		}
+
+		// the workers of the lock-free pool do not go to sleep right away, so the job added meanwhile is taken
+		// without any wakeup. Spinning workers are not counted as waiting, so adding the job does not notify them
+		if((pool->jobQueue == QueueType::LockFree) && pool->spinForJob(index, job, priority))
+		{
+			pool->runJob(job, priority);
+			continue;
+		}
+
+		// if there are no more jobs, or we're paused, go into waiting mode
+		{
+			std::unique_lock<std::mutex> idleLock{pool->idleMutex};
+
+			++pool->threadsWaiting;
+			pool->jobsAvailable.wait(idleLock, [&]()
+			{
+				return pool->terminate || worker.retire || !((pool->pendingJobs == 0) || pool->paused);
+			});
+			--pool->threadsWaiting;
+		}
+	}
+
+	currentWorker = WorkerContext{ nullptr, 0, Priority::Normal, 0 };
+}
+
+CORE_EXPORT void ThreadPool::timerTask(ThreadPool* pool)
+{
+	std::unique_lock<std::mutex> timerLock{pool->timerMutex};
+
+	while(!pool->terminate)
+	{
+		bool dumping = pool->dumpPeriod > std::chrono::steady_clock::duration::zero();
+
+		if(pool->delayedJobs.empty() && !dumping)
+		{
+			pool->timerChanged.wait(timerLock);
+			continue;
+		}
+
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+		if(dumping && (now >= pool->nextDump))
+		{
+			pool->nextDump = now + pool->dumpPeriod;
+
+			auto sink = pool->dumpSink;
+
+			// the sink must not block the delayed jobs from being queued
+			timerLock.unlock();
+			sink(pool->statistics());
+			timerLock.lock();
+
+			continue;
+		}
+
+		std::chrono::steady_clock::time_point next = dumping ? pool->nextDump : std::chrono::steady_clock::time_point::max();
+
+		if(!pool->delayedJobs.empty())
+			next = std::min(next, pool->delayedJobs.front().deadline);
+
+		if(now < next)
+		{
+			pool->timerChanged.wait_until(timerLock, next);
+			continue;
+		}
+
+		std::pop_heap(pool->delayedJobs.begin(), pool->delayedJobs.end(), isLater<DelayedJob>);
+
+		DelayedJob due = std::move(pool->delayedJobs.back());
+		pool->delayedJobs.pop_back();
+
+		timerLock.unlock();
+
+		// the job is queued (counted unfinished once more) before it stops being counted as delayed
+		{
+			NodeHint hint(due.node);
+
+			pool->enqueue(std::move(due.job), due.priority);
+		}
+		pool->finishJobs(1);
+
+		timerLock.lock();
+	}
+}
+
+CORE_EXPORT ThreadPoolStatistics ThreadPool::statistics() const
+{
+	ThreadPoolStatistics ret{};
+
+	std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::duration( statisticsStart.load() ) };
+
+	ret.mPeriod = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	ret.mWaitingJobs = pendingJobs;
+	ret.mFailedJobs = failedJobs;
+	ret.mCancelledJobs = cancelledJobs;
+
+	std::size_t active = activeWorkers;
+	std::size_t used = usedWorkers;
+
+	// the retired workers do not run any more, but the jobs they ran are part of the histograms
+	for(std::size_t index = 0; index < used; ++index)
+	{
+		const Worker& worker = *workers[index];
+
+		worker.waitTime.collect(ret.mWaitTime);
+		worker.runTime.collect(ret.mRunTime);
+		worker.queueDepth.collect(ret.mQueueDepth);
+
+		if(index < active)
+		{
+			std::chrono::nanoseconds busy{ static_cast<std::chrono::nanoseconds::rep>(worker.busyTime.load(std::memory_order_relaxed)) };
+			double utilisation = (ret.mPeriod.count() > 0) ? (static_cast<double>(busy.count()) / static_cast<double>(ret.mPeriod.count())) : 0.0;
+
+			ret.mWorkers.push_back(ThreadPoolStatistics::Worker{ worker.jobsRun.load(std::memory_order_relaxed), busy, utilisation });
+		}
+	}
+
+	return ret;
+}
+
+CORE_EXPORT void ThreadPool::resetStatistics()
+{
+	std::size_t used = usedWorkers;
+
+	for(std::size_t index = 0; index < used; ++index)
+	{
+		Worker& worker = *workers[index];
+
+		worker.waitTime.reset();
+		worker.runTime.reset();
+		worker.queueDepth.reset();
+		worker.jobsRun = 0;
+		worker.busyTime = 0;
+	}
+
+	failedJobs = 0;
+	cancelledJobs = 0;
+
+	statisticsStart = std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+CORE_EXPORT void ThreadPool::dumpStatistics(std::chrono::milliseconds period, std::function<void(const ThreadPoolStatistics&)> sink)
+{
+	if(!sink)
+		sink = [](const ThreadPoolStatistics& statistics) { std::cout << statistics; };
+
+	{
+		std::lock_guard<std::mutex> timerLock{timerMutex};
+
+		dumpPeriod = std::max<std::chrono::steady_clock::duration>(period, std::chrono::steady_clock::duration::zero());
+		nextDump = std::chrono::steady_clock::now() + dumpPeriod;
+		dumpSink = std::move(sink);
+
+		// the timer stopped by shutdown() is not started again
+		if((dumpPeriod > std::chrono::steady_clock::duration::zero()) && !timer.joinable() && !terminate)
+			timer = std::thread{timerTask, this};
+	}
+
+	timerChanged.notify_one();
+}
+
+CORE_EXPORT void ThreadPool::setFailureHandler(FailureHandler handler)
+{
+	std::lock_guard<std::mutex> failureLock{failureMutex};
+
+	failureHandler = std::move(handler);
+}
+
+CORE_EXPORT std::vector<JobFailure> ThreadPool::recentFailures() const
+{
+	std::lock_guard<std::mutex> failureLock{failureMutex};
+
+	return std::vector<JobFailure>(failures.begin(), failures.end());
+}
+
+CORE_EXPORT void ThreadPool::recordFailure(const std::exception_ptr& exception) noexcept
+{
+	try
+	{
+		// cancellation is the expected outcome of the superseded work, not a failure
+		try
+		{
+			std::rethrow_exception(exception);
+		}
+		catch(const Exception::OperationCancelled&)
+		{
+			++cancelledJobs;
+			return;
+		}
+		catch(...)
+		{
+		}
+
+		++failedJobs;
+
+		JobFailure failure = JobFailure::describe(exception);
+		FailureHandler handler;
+
+		{
+			std::lock_guard<std::mutex> failureLock{failureMutex};
+
+			if(failures.size() == RecentFailureCount)
+				failures.pop_front();
+
+			failures.push_back(failure);
+			handler = failureHandler;
+		}
+
+		if(handler)
+			handler(failure);
+	}
+	catch(...)
+	{
+		// neither describing the failure nor the handler may break the job wrapper reporting it
+	}
+}
+
+CORE_EXPORT void Detail::reportJobFailure(const std::exception_ptr& exception) noexcept
+{
+	if(currentWorker.pool != nullptr)
+		currentWorker.pool->recordFailure(exception);
 }
@@ -13,14 +13,34 @@
 #include <mutex>
 #include <thread>
 #include <future>
+#include <chrono>
 #include <vector>
 #include <functional>
 #include <condition_variable>
-#include <queue>
+#include <memory>
+#include <array>
+#include <iterator>
+#include <exception>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <limits>
+#include <string>
+#include <deque>
 
 /* Boost inclusions */
 #include <boost/serialization/singleton.hpp>
 
+/* Project specific inclusions */
+#include "ThreadPool/WorkStealingQueue.h"
+#include "ThreadPool/MpmcQueue.h"
+#include "ThreadPool/Task.h"
+#include "ThreadPool/Cancellation.h"
+#include "ThreadPool/Statistics.h"
+#include "ThreadPool/Topology.h"
+#include "ThreadPool/Failure.h"
+#include "ThreadPool/Exception.h"
+
 /* Shared library support */
 #include "Core_Export.h"
 
@@ -34,90 +54,792 @@
 
 /* NOTE: The ThreadPool implementation is forked from: https://github.com/dabbertorres/ThreadPool */
 
+/* NOTE: Every worker owns its work stealing queue. Jobs added from a worker thread are pushed to the worker's own
+ * queue (and popped LIFO by that worker), jobs added from any other thread are distributed among the workers
+ * round-robin. Idle workers steal the oldest jobs from the others.
+ *
+ * Every queue is split into priority lanes. Workers prefer higher priority lanes, but every few jobs a lower
+ * priority lane is served first, so the background jobs cannot starve while interactive ones keep coming.
+ *
+ * Workers may be pinned to the CPUs. Pinned workers are spread among the NUMA nodes round-robin (worker i runs on
+ * node i % nodeCount), idle workers steal from the workers of their own node first and jobs added under a NodeHint
+ * are queued on the workers of the hinted node, so the data the jobs work on is not dragged across the sockets.
+ *
+ * The singleton is the default pool used by everything not asking for another one. Independent named pools (e.g.
+ * one for the blocking I/O) may be created either directly or through the registry (ThreadPool::create()), so the
+ * jobs blocking their workers cannot starve the CPU-bound jobs of the default pool.
+ *
+ * Alternatively, the pool may be constructed with a shared bounded lock-free queue per priority lane (QueueType::
+ * LockFree). Any thread pushes to and any worker pops from the shared queue without taking a lock, idle workers spin
+ * for a while before going to sleep, so a job added to a busy pool does not cost any wakeup at all. Jobs which do
+ * not fit the shared queue overflow to the work stealing queues.
+ *
+ * For debugging and for the serial baselines of the benchmarks, the pool may be switched to the serial execution
+ * mode. It shrinks to single worker taking the jobs from single FIFO queue, so the jobs run one by one in the order
+ * they were added and the runs are reproducible. */
+
 namespace Core
 {
+	template<typename RESULT>
+	class Future;
+
 	class CORE_EXPORT ThreadPool
-		:	/* ThreadPool is a SINGLETON */
+		:	/* The default ThreadPool is a SINGLETON */
 			public boost::serialization::singleton<ThreadPool>
 	{
 	public:
 		using Ids = std::vector<std::thread::id>;
 
-		// add a function to be executed, along with any arguments for it
+		// name of the singleton pool
+		static const char* const DefaultName;
+
+		// queues the jobs are passed to the workers through
+		enum class QueueType
+		{
+			// queue per worker, the idle workers steal from the others
+			WorkStealing,
+			// single bounded lock-free queue shared by all the workers, the idle ones spin before going to sleep.
+			// Node hints are ignored as long as the shared queue is not full
+			LockFree
+		};
+
+		// starts count threads, waiting for jobs. The pool is independent of the singleton
+		// may throw a std::system_error if a thread could not be started
+		explicit ThreadPool(std::string name, std::size_t count = defaultThreadCount(), QueueType queue = QueueType::WorkStealing);
+
+		// shuts the pool down without draining, see shutdown(). It must not be destroyed by its own worker,
+		// the process is terminated then
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// creates a pool registered under the name, so it can be looked up by instance(name). Throws
+		// Core::Exception::InvalidThreadPoolOperation if the name is used already
+		static ThreadPool& create(const std::string& name, std::size_t count = defaultThreadCount(), QueueType queue = QueueType::WorkStealing);
+
+		// returns the pool registered under the name, the singleton for DefaultName. Throws
+		// Core::Exception::InvalidThreadPoolOperation if there is no such pool
+		static ThreadPool& instance(const std::string& name);
+
+		// unregisters and destroys the pool created by create(name), waiting for its running jobs.
+		// Nothing may use the pool any more. Returns false if there is no such pool. Throws
+		// Core::Exception::InvalidThreadPoolOperation if called by the pool's own worker
+		static bool destroy(const std::string& name);
+
+		// returns the name of the pool
+		const std::string& name() const;
+
+		// job priority lanes, from the most urgent one
+		enum class Priority : std::size_t
+		{
+			// jobs the user is waiting for (e.g. update of the component being edited)
+			Interactive,
+			Normal,
+			// bulk jobs nobody is waiting for (e.g. batch regeneration)
+			Background
+		};
+
+		// placement of the workers on the CPUs
+		enum class Affinity
+		{
+			// workers run wherever the OS schedules them, node hints are ignored
+			None,
+			// every worker is pinned to single CPU
+			Core,
+			// every worker is pinned to the CPUs of its NUMA node
+			Node
+		};
+
+		// node hint not preferring any node
+		static constexpr std::size_t AnyNode = std::numeric_limits<std::size_t>::max();
+
+		// queues the jobs added by the calling thread on the workers of the node while the hint exists, unless
+		// the affinity is None. Hints nest, the previous one is restored once the hint is destroyed. Nested
+		// jobs added by a worker of the hinted node stay on the worker's own queue as usual
+		class CORE_EXPORT NodeHint
+		{
+		public:
+			explicit NodeHint(std::size_t node);
+			~NodeHint();
+
+			NodeHint(const NodeHint&) = delete;
+			NodeHint& operator=(const NodeHint&) = delete;
+
+		private:
+			std::size_t previous;
+		};
+
+		// add a function to be executed, along with any arguments for it. Jobs added from a pool
+		// worker inherit the priority of the job being run, the others are run with Normal priority
+		template<typename FUNCTION, typename... ARGUMENTS>
+		auto add(FUNCTION&& Function, ARGUMENTS&&... Arguments) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>;
+
+		// add a function to be executed with given priority, along with any arguments for it
+		template<typename FUNCTION, typename... ARGUMENTS>
+		auto add(Priority priority, FUNCTION&& Function, ARGUMENTS&&... Arguments) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>;
+
+		// add a function to be executed unless the token is cancelled before the job starts. The future of
+		// the cancelled job throws Core::Exception::OperationCancelled. The priority is taken the same way
+		// as by add(Function, Arguments...)
+		template<typename FUNCTION, typename... ARGUMENTS>
+		auto add(const CancellationToken& token, FUNCTION&& Function, ARGUMENTS&&... Arguments) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>;
+
+		// add a cancellable function to be executed with given priority
 		template<typename FUNCTION, typename... ARGUMENTS>
-		auto add(FUNCTION&& Function, ARGUMENTS&&... Arguments) -> std::future<typename std::result_of<FUNCTION(ARGUMENTS...)>::type>;
+		auto add(Priority priority, const CancellationToken& token, FUNCTION&& Function, ARGUMENTS&&... Arguments) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>;
+
+		// add a function to be executed once the delay expires, along with any arguments for it. The job is not
+		// queued until then, but it is counted as unfinished, so wait() waits for it. The priority is taken the
+		// same way as by add(Function, Arguments...)
+		template<typename REP, typename PERIOD, typename FUNCTION, typename... ARGUMENTS>
+		auto addAfter(const std::chrono::duration<REP, PERIOD>& delay, FUNCTION&& Function, ARGUMENTS&&... Arguments) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>;
+
+		// add a function to be executed with given priority once the delay expires
+		template<typename REP, typename PERIOD, typename FUNCTION, typename... ARGUMENTS>
+		auto addAfter(Priority priority, const std::chrono::duration<REP, PERIOD>& delay, FUNCTION&& Function, ARGUMENTS&&... Arguments) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>;
+
+		// result of the callable the iterator points to
+		template<typename ITERATOR>
+		using BatchResult = typename std::invoke_result<typename std::decay<typename std::iterator_traits<ITERATOR>::value_type>::type&>::type;
+
+		// add a job for every callable (taking no arguments) in the range, all of them at once. Returns the futures
+		// in the order of the callables. The priority is taken the same way as by add(Function, Arguments...)
+		template<typename ITERATOR>
+		auto addBatch(ITERATOR First, ITERATOR Last) -> std::vector<std::future<BatchResult<ITERATOR>>>;
+
+		// add a job for every callable (taking no arguments) in the range with given priority, all of them at once
+		template<typename ITERATOR>
+		auto addBatch(Priority priority, ITERATOR First, ITERATOR Last) -> std::vector<std::future<BatchResult<ITERATOR>>>;
+
+		// calls Function(index) for every index of <First, Last). The range is split into chunks of Grain indices
+		// (0 chooses the grain automatically) run in parallel. Blocks until all the chunks are finished, helping
+		// with the queued jobs if called from a pool worker. The first exception thrown by Function is rethrown
+		template<typename INDEX, typename FUNCTION>
+		void parallelFor(INDEX First, INDEX Last, INDEX Grain, FUNCTION&& Function);
+
+		// reduces Function(index) results of every index of <First, Last) using Reduction, starting with Identity.
+		// The range is split and joined the same way as by parallelFor(). Reduction must be associative, it is
+		// not required to be commutative as the partial results are reduced in the order of the indices
+		template<typename INDEX, typename VALUE, typename FUNCTION, typename REDUCTION>
+		VALUE parallelReduce(INDEX First, INDEX Last, INDEX Grain, VALUE Identity, FUNCTION&& Function, REDUCTION&& Reduction);
 
 		// returns number of threads being used
 		std::size_t threadCount() const;
 
+		// returns number of threads started by default. It is taken from CORE_THREADPOOL_SIZE
+		// environment variable if set, std::thread::hardware_concurrency() is used otherwise
+		static std::size_t defaultThreadCount();
+
+		// grows or shrinks the pool to count threads. Queued jobs are not dropped, the jobs queued
+		// by the retired workers are taken over by the remaining ones. Blocks until the retired workers
+		// finish their current jobs so it must not be called from a pool worker
+		void resize(std::size_t count);
+
+		// pins the workers according to the affinity, including the running ones. Initial affinity is taken
+		// from CORE_THREADPOOL_AFFINITY environment variable (none, core or node), None is used if not set
+		void setAffinity(Affinity affinity);
+
+		// returns the current affinity of the workers
+		Affinity affinity() const;
+
+		// returns the NUMA nodes and CPUs the workers are placed on
+		const CpuTopology& topology() const;
+
+		// returns the node of the calling worker, or the node of the CPU the calling thread runs on if called
+		// from outside of the pool (or if the workers are not pinned)
+		std::size_t currentNode() const;
+
+		// how the jobs are executed
+		enum class ExecutionMode
+		{
+			// jobs run in parallel on all the workers
+			Parallel,
+			// jobs run one by one on single worker in the order they were added, regardless of their priority
+			// and node hint
+			Serial
+		};
+
+		// switches the execution mode. Serial mode shrinks the pool to single worker, the thread count is restored
+		// once switched back to Parallel (resize() called meanwhile just changes the count to be restored). Jobs
+		// queued before the switch are not reordered. Blocks the same way as resize() does, so it must not be
+		// called from a pool worker. Initial mode is taken from CORE_THREADPOOL_MODE environment variable
+		// (parallel or serial), Parallel is used if not set
+		void setExecutionMode(ExecutionMode mode);
+
+		// returns the current execution mode
+		ExecutionMode executionMode() const;
+
+		// returns the type of the queues chosen at the construction. The singleton uses CORE_THREADPOOL_QUEUE
+		// environment variable (workstealing or lockfree), WorkStealing is used if not set
+		QueueType queueType() const;
+
 		// returns the number of jobs waiting to be executed
 		std::size_t waitingJobs() const;
 
 		// returns a vector of ids of the threads used by the ThreadPool
 		Ids ids() const;
 
-		// clears currently queued jobs (jobs which are not currently running)
+		// clears currently queued jobs (jobs which are not currently running), including the delayed ones
 		void clear();
 
+		// queues all the delayed jobs right away, not waiting for their delays to expire. Returns the number of jobs queued
+		std::size_t flushDelayed();
+
+		// outcome of shutdown()
+		struct ShutdownReport
+		{
+			// all the jobs were finished before the deadline
+			bool drained;
+
+			// number of jobs dropped without being run, their futures fail with std::future_error (broken_promise)
+			std::size_t droppedJobs;
+		};
+
+		// stops the pool. If drain is set, the queued jobs (and the jobs they add) are run until the deadline first.
+		// Delayed jobs are not waited for, they are queued right away as well as the jobs delayed while draining, so
+		// the debounced component updates are flushed. Jobs left once the deadline passes are dropped and reported.
+		// Blocks until the running jobs are finished, so it must not be called from a pool worker. Jobs cannot
+		// be added once the pool is shut down, add() throws Core::Exception::InvalidThreadPoolOperation then.
+		// Shutting down the pool stopped already does nothing
+		ShutdownReport shutdown(bool drain, std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+		// stops the pool the same way as shutdown(drain, deadline) does, draining at most for the timeout
+		template<typename REP, typename PERIOD>
+		ShutdownReport shutdown(bool drain, const std::chrono::duration<REP, PERIOD>& timeout);
+
+		// returns true once shutdown() was called
+		bool isShuttingDown() const;
+
+		// returns true once the workers are stopped by shutdown(), add() throws then
+		bool isStopped() const;
+
+		using FailureHandler = std::function<void(const JobFailure&)>;
+
+		// number of recent failures kept by the pool
+		static constexpr std::size_t RecentFailureCount = 32;
+
+		// calls handler for every job failed with an exception (except the cancelled ones), on the worker running
+		// the job right after the failure. Exceptions thrown by the handler are ignored. Null handler stops it
+		void setFailureHandler(FailureHandler handler);
+
+		// returns the last RecentFailureCount failures, the oldest first
+		std::vector<JobFailure> recentFailures() const;
+
 		// pause and resume job execution. Does not affect currently running jobs
 		void pause(bool state);
 
-		// blocks calling thread until job queue is empty
+		// blocks calling thread until all the queued and running jobs are finished. It must not be
+		// called from a pool worker as the job calling it would never finish
 		void wait();
 
-	protected:
-#if false
-		using ThreadCount = std::integral_constant<std::size_t, 4>;
-#endif
+		// blocks calling thread the same way as wait() does, but at most until the deadline.
+		// Returns false if the jobs have not been finished in time
+		bool waitUntil(std::chrono::steady_clock::time_point deadline);
+
+		// blocks calling thread the same way as wait() does, but at most for the timeout
+		template<typename REP, typename PERIOD>
+		bool waitFor(const std::chrono::duration<REP, PERIOD>& timeout);
 
-		// starts threadCount threads, waiting for jobs
+		// blocks calling thread until the future is ready. Pool workers keep executing other
+		// queued jobs meanwhile, so a job waiting for its own sub-jobs never parks a worker.
+		// Any other thread just blocks on the future
+		template<typename RESULT>
+		void wait(const std::future<RESULT>& future);
+
+		// waits for the future the same way as wait(future) does and returns its result
+		template<typename RESULT>
+		RESULT get(std::future<RESULT>& future);
+
+		// returns the statistics collected since the pool was started or since the last reset. Counters are
+		// updated by the workers without any synchronization, so the snapshot is not exactly consistent
+		ThreadPoolStatistics statistics() const;
+
+		// starts collecting the statistics from scratch
+		void resetStatistics();
+
+		// calls sink with the statistics snapshot every period, printing it to std::cout if no sink is given.
+		// Zero period stops dumping. Dumping is started by CORE_THREADPOOL_STATISTICS environment variable
+		// as well, if set to the period in milliseconds. Nothing is dumped once the pool is shut down
+		void dumpStatistics(std::chrono::milliseconds period, std::function<void(const ThreadPoolStatistics&)> sink = nullptr);
+
+	protected:
+		// starts defaultThreadCount() threads of the singleton, waiting for jobs
 		// may throw a std::system_error if a thread could not be started
 		ThreadPool( void );
 
-		// clears job queue, then blocks until all threads are finished executing their current job
-		~ThreadPool();
-
 	private:
-		using Job = std::function<void()>;
+		// futures help with the queued jobs while waiting
+		template<typename RESULT>
+		friend class Future;
+
+		// job wrappers report the failures to the pool running them
+		friend void Detail::reportJobFailure(const std::exception_ptr& exception) noexcept;
+
+		// accounts the failure of the job run by the calling worker
+		void recordFailure(const std::exception_ptr& exception) noexcept;
+
+		// move-only job storing small callables inline, see Detail::Task
+		struct Job
+		{
+			Job() = default;
+
+			template<typename FUNCTION, typename = typename std::enable_if<!std::is_same<typename std::decay<FUNCTION>::type, Job>::value>::type>
+			explicit Job(FUNCTION&& function) : task(std::forward<FUNCTION>(function)) {}
+
+			Detail::Task task;
+
+			// time the job was queued at, to measure how long it waited
+			std::chrono::steady_clock::time_point queued;
+		};
+
+		static constexpr std::size_t PriorityCount = 3;
+
+		// capacity of every shared lock-free lane
+		static constexpr std::size_t SharedQueueCapacity = 4096;
+
+		struct Worker
+		{
+			// jobs owned by the worker, stolen by the others. One queue per priority lane
+			std::array<Detail::WorkStealingQueue<Job>, PriorityCount> jobs;
+
+			// number of jobs taken by the worker, drives the order the lanes are served in
+			std::size_t ticks = 0;
+
+			std::thread thread;
+
+			// set once the worker shall finish as the pool shrinks
+			std::atomic<bool> retire{false};
+
+			// statistics, written by the worker only
+			HistogramRecorder waitTime;
+			HistogramRecorder runTime;
+			HistogramRecorder queueDepth;
+			std::atomic<std::uint64_t> jobsRun{0};
+			std::atomic<std::uint64_t> busyTime{0};
+		};
+
+		// job waiting for its delay to expire
+		struct DelayedJob
+		{
+			std::chrono::steady_clock::time_point deadline;
+			Job job;
+			Priority priority;
+
+			// node hint of the thread which added the job
+			std::size_t node;
+		};
 
 		// function each thread performs
-		static void threadTask(ThreadPool* pool);
+		static void threadTask(ThreadPool* pool, std::size_t index);
+
+		// function the timer thread performs, it queues the delayed jobs once due
+		static void timerTask(ThreadPool* pool);
+
+		// starts worker thread in the given slot, allocating the slot if not used yet
+		void startWorker(std::size_t index);
+
+		// pins the worker according to the current affinity
+		void pinWorker(std::size_t index);
+
+		// grows or shrinks the pool to count threads, or to single thread in the serial mode. Must be called
+		// with resizeMutex locked
+		void resizeWorkers(std::size_t count);
+
+		// returns the number of nodes the workers are spread among, 1 if they are not pinned
+		std::size_t placementNodes() const;
+
+		// returns the worker the job added by the calling thread is queued on, following its node hint
+		std::size_t queueIndex();
+
+		// pushes the job to the calling worker's queue or, if called from outside, to the next worker's queue
+		void enqueue(Job&& job, Priority priority);
+
+		// keeps the job aside until the deadline, starting the timer thread if not running yet
+		void enqueueAt(Job&& job, Priority priority, std::chrono::steady_clock::time_point deadline);
+
+		// pushes all the jobs to single worker's queue at once, the others steal them from there
+		void enqueueBatch(std::vector<Job>& jobs, Priority priority);
+
+		// pushes the jobs to the serial queue. Once the pool became parallel meanwhile, they are left as the backlog
+		template<typename ITERATOR>
+		void pushSerial(ITERATOR first, ITERATOR last);
+
+		// returns the priority of the job being run by the calling worker, Normal if called from outside
+		Priority currentPriority() const;
+
+		// returns the number of indices in a parallelFor() or parallelReduce() chunk for the given range size
+		std::size_t grainSize(std::size_t count) const;
+
+		// splits <First, Last) to chunks and adds a job running Chunk(begin, end) for every chunk but the first one,
+		// which is left for the calling thread. Returns the end of the first chunk and the futures of the others
+		template<typename INDEX, typename CHUNK>
+		auto addChunks(INDEX First, INDEX Last, INDEX Grain, CHUNK& Chunk) -> std::pair<INDEX, std::vector<std::future<typename std::invoke_result<CHUNK&, INDEX, INDEX>::type>>>;
+
+		// takes a job from the shared queue, worker's own queue or steals one from the other workers
+		bool findJob(std::size_t index, Job& job, Priority& priority);
+
+		// keeps looking for a job for a while before the worker goes to sleep. Returns false once given up
+		bool spinForJob(std::size_t index, Job& job, Priority& priority);
+
+		// drops all the queued and delayed jobs, returns the number of jobs dropped
+		std::size_t dropJobs();
+
+		// throws if the pool does not accept jobs any more
+		void checkRunning() const;
+
+		// accounts count jobs finished (or dropped), releasing the threads waiting once there are none left
+		void finishJobs(std::size_t count);
+
+		// runs the job taken out of the queue and accounts it finished
+		void runJob(Job& job, Priority priority);
+
+		// returns true if called from a worker of this pool
+		bool isWorker() const;
+
+		// runs one queued job on the calling worker. Returns false if called from outside
+		// of the pool or if there is no job to be run
+		bool runPendingJob();
+
+		// upper limit of the worker threads. Worker slots are allocated up to this count and never
+		// move or get released while the pool is running, so no lock is needed to access them
+		const std::size_t MaxThreadCount;
+
+		const std::string poolName;
+
+		const QueueType jobQueue;
+
+		// shared lanes, used by the LockFree pool only
+		std::array<std::unique_ptr<Detail::MpmcQueue<Job>>, PriorityCount> sharedJobs;
+
+		const CpuTopology cpuTopology;
 
-		const unsigned int ThreadCount;
+		std::unique_ptr<std::unique_ptr<Worker>[]> workers;
 
-		std::queue<Job> jobs;
-		mutable std::mutex jobsMutex;
+		// changed under resizeMutex
+		std::atomic<Affinity> workerAffinity;
+
+		// number of running workers
+		std::atomic<std::size_t> activeWorkers;
+
+		// number of worker slots ever used. Jobs may still wait in the queues of retired workers
+		std::atomic<std::size_t> usedWorkers;
+
+		// serializes resizing of the pool
+		mutable std::mutex resizeMutex;
+
+		// changed under resizeMutex
+		std::atomic<ExecutionMode> jobExecution;
+
+		// number of workers requested, the serial pool runs single one. Guarded by resizeMutex
+		std::size_t parallelThreadCount;
+
+		// jobs of the serial pool in the order they were added
+		Detail::WorkStealingQueue<Job> serialJobs;
+
+		// set while the jobs left in serialJobs by the switch to parallel execution are not all taken yet
+		std::atomic<bool> serialBacklog;
+
+		// set while the jobs queued before the switch to serial execution are moved to serialJobs, no job is
+		// taken meanwhile
+		std::atomic<bool> becomingSerial;
+
+		// number of jobs enqueued but not taken by any worker yet
+		std::atomic<std::size_t> pendingJobs;
+
+		// number of jobs enqueued but not finished yet (queued or running)
+		std::atomic<std::size_t> unfinishedJobs;
+
+		// notification variable for threads waiting for all the jobs to be finished
+		mutable std::mutex finishedMutex;
+		std::condition_variable jobsFinished;
+
+		// queue to be used by the next job added from outside of the pool
+		std::atomic<std::size_t> nextQueue;
 
 		// notification variable for waiting threads
+		mutable std::mutex idleMutex;
 		std::condition_variable jobsAvailable;
 
-		std::vector<std::thread> threads;
 		std::atomic<std::size_t> threadsWaiting;
 
+		// jobs waiting for their delay to expire, ordered as a heap by the deadline
+		std::mutex timerMutex;
+		std::condition_variable timerChanged;
+		std::vector<DelayedJob> delayedJobs;
+
+		// started by the first delayed job
+		std::thread timer;
+
+		// time the statistics are collected since, in steady_clock ticks
+		std::atomic<std::chrono::steady_clock::rep> statisticsStart;
+
+		// statistics dumped by the timer thread, guarded by timerMutex
+		std::chrono::steady_clock::duration dumpPeriod;
+		std::chrono::steady_clock::time_point nextDump;
+		std::function<void(const ThreadPoolStatistics&)> dumpSink;
+
 		std::atomic<bool> terminate;
 		std::atomic<bool> paused;
+
+		// set by shutdown(), the delayed jobs are queued right away from then on
+		std::atomic<bool> shuttingDown;
+
+		// set once the workers are stopped, no job is accepted any more
+		std::atomic<bool> stopped;
+
+		// number of threads queueing a job right now, shutdown() waits for them before dropping the jobs left
+		std::atomic<std::size_t> producers;
+
+		// serializes shutdown() calls
+		std::mutex shutdownMutex;
+
+		std::atomic<std::uint64_t> failedJobs;
+		std::atomic<std::uint64_t> cancelledJobs;
+
+		// recent failures and the handler, guarded by failureMutex
+		mutable std::mutex failureMutex;
+		std::deque<JobFailure> failures;
+		FailureHandler failureHandler;
 	};
 
 	template<typename FUNCTION, typename... ARGUMENTS>
-	auto ThreadPool::add( FUNCTION&& Function, ARGUMENTS&&... Arguments ) -> std::future<typename std::result_of<FUNCTION(ARGUMENTS...)>::type>
+	auto ThreadPool::add( FUNCTION&& Function, ARGUMENTS&&... Arguments ) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>
 	{
-		using PackedTask = std::packaged_task<typename std::result_of<FUNCTION(ARGUMENTS...)>::type()>;
+		return add(currentPriority(), std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+	}
 
-		auto task = std::make_shared<PackedTask>(std::bind(std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...));
+	template<typename FUNCTION, typename... ARGUMENTS>
+	auto ThreadPool::add( Priority priority, FUNCTION&& Function, ARGUMENTS&&... Arguments ) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>
+	{
+		using PackedTask = Detail::PackagedCall<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type, typename std::decay<FUNCTION>::type, typename std::decay<ARGUMENTS>::type...>;
+
+		// the call is stored in the job itself and the shared state of the future is pooled,
+		// so adding a small job does not touch the heap
+		PackedTask task(std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
 
 		// get the future to return later
-		auto ret = task->get_future();
+		auto ret = task.getFuture();
+
+		enqueue(Job(std::move(task)), priority);
+
+		return ret;
+	}
 
+	template<typename FUNCTION, typename... ARGUMENTS>
+	auto ThreadPool::add( const CancellationToken& token, FUNCTION&& Function, ARGUMENTS&&... Arguments ) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>
+	{
+		return add(currentPriority(), token, std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+	}
+
+	template<typename FUNCTION, typename... ARGUMENTS>
+	auto ThreadPool::add( Priority priority, const CancellationToken& token, FUNCTION&& Function, ARGUMENTS&&... Arguments ) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>
+	{
+		// the token is checked once the job is taken out of the queue, right before the function would be called
+		return add(priority, Detail::CancellableCall<typename std::decay<FUNCTION>::type>(token, std::forward<FUNCTION>(Function)), std::forward<ARGUMENTS>(Arguments)...);
+	}
+
+	template<typename REP, typename PERIOD, typename FUNCTION, typename... ARGUMENTS>
+	auto ThreadPool::addAfter(const std::chrono::duration<REP, PERIOD>& delay, FUNCTION&& Function, ARGUMENTS&&... Arguments) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>
+	{
+		return addAfter(currentPriority(), delay, std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+	}
+
+	template<typename REP, typename PERIOD, typename FUNCTION, typename... ARGUMENTS>
+	auto ThreadPool::addAfter(Priority priority, const std::chrono::duration<REP, PERIOD>& delay, FUNCTION&& Function, ARGUMENTS&&... Arguments) -> std::future<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type>
+	{
+		using PackedTask = Detail::PackagedCall<typename std::invoke_result<FUNCTION, ARGUMENTS...>::type, typename std::decay<FUNCTION>::type, typename std::decay<ARGUMENTS>::type...>;
+
+		PackedTask task(std::forward<FUNCTION>(Function), std::forward<ARGUMENTS>(Arguments)...);
+
+		auto ret = task.getFuture();
+
+		enqueueAt(Job(std::move(task)), priority, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay));
+
+		return ret;
+	}
+
+	template<typename ITERATOR>
+	auto ThreadPool::addBatch(ITERATOR First, ITERATOR Last) -> std::vector<std::future<BatchResult<ITERATOR>>>
+	{
+		return addBatch(currentPriority(), First, Last);
+	}
+
+	template<typename ITERATOR>
+	auto ThreadPool::addBatch(Priority priority, ITERATOR First, ITERATOR Last) -> std::vector<std::future<BatchResult<ITERATOR>>>
+	{
+		using PackedTask = Detail::PackagedCall<BatchResult<ITERATOR>, typename std::decay<typename std::iterator_traits<ITERATOR>::value_type>::type>;
+
+		std::vector<Job> jobs;
+		std::vector<std::future<BatchResult<ITERATOR>>> ret;
+
+		for(; First != Last; ++First)
 		{
-			std::lock_guard<std::mutex> lock{jobsMutex};
-			jobs.emplace([task]() { (*task)(); });
+			PackedTask task(*First);
+
+			ret.push_back(task.getFuture());
+			jobs.emplace_back(std::move(task));
 		}
 
-		// let a waiting thread know there is an available job
-		jobsAvailable.notify_one();
+		enqueueBatch(jobs, priority);
 
 		return ret;
 	}
+
+	template<typename INDEX, typename CHUNK>
+	auto ThreadPool::addChunks(INDEX First, INDEX Last, INDEX Grain, CHUNK& Chunk) -> std::pair<INDEX, std::vector<std::future<typename std::invoke_result<CHUNK&, INDEX, INDEX>::type>>>
+	{
+		static_assert(std::is_integral<INDEX>::value, "Parallel loop index must be of integral type.");
+
+		std::size_t count = static_cast<std::size_t>(Last - First);
+		std::size_t grain = (Grain > 0) ? static_cast<std::size_t>(Grain) : grainSize(count);
+
+		auto makeJob = [&Chunk](INDEX begin, INDEX end) { return [&Chunk, begin, end]() { return Chunk(begin, end); }; };
+
+		std::vector<decltype(makeJob(First, Last))> jobs;
+
+		for(std::size_t begin = grain; begin < count; begin += grain)
+			jobs.push_back(makeJob(First + static_cast<INDEX>(begin), First + static_cast<INDEX>(std::min(begin + grain, count))));
+
+		return std::make_pair(First + static_cast<INDEX>(std::min(grain, count)), addBatch(jobs.begin(), jobs.end()));
+	}
+
+	template<typename INDEX, typename FUNCTION>
+	void ThreadPool::parallelFor(INDEX First, INDEX Last, INDEX Grain, FUNCTION&& Function)
+	{
+		if(!(First < Last))
+			return;
+
+		auto chunk = [&Function](INDEX begin, INDEX end)
+		{
+			for(INDEX index = begin; index < end; ++index)
+				Function(index);
+		};
+
+		auto chunks = addChunks(First, Last, Grain, chunk);
+
+		std::exception_ptr error;
+
+		try
+		{
+			chunk(First, chunks.first);
+		}
+		catch(...)
+		{
+			error = std::current_exception();
+		}
+
+		// the chunks refer to Function, so all of them are waited for even if some of them fail
+		for(auto& future : chunks.second)
+		{
+			wait(future);
+
+			try
+			{
+				future.get();
+			}
+			catch(...)
+			{
+				if(!error)
+					error = std::current_exception();
+			}
+		}
+
+		if(error)
+			std::rethrow_exception(error);
+	}
+
+	template<typename INDEX, typename VALUE, typename FUNCTION, typename REDUCTION>
+	VALUE ThreadPool::parallelReduce(INDEX First, INDEX Last, INDEX Grain, VALUE Identity, FUNCTION&& Function, REDUCTION&& Reduction)
+	{
+		if(!(First < Last))
+			return Identity;
+
+		// every partial result starts with the Identity
+		auto chunk = [&Function, &Reduction, &Identity](INDEX begin, INDEX end)
+		{
+			VALUE partial = Identity;
+
+			for(INDEX index = begin; index < end; ++index)
+				partial = Reduction(std::move(partial), Function(index));
+
+			return partial;
+		};
+
+		auto chunks = addChunks(First, Last, Grain, chunk);
+
+		VALUE result = Identity;
+		std::exception_ptr error;
+
+		try
+		{
+			result = chunk(First, chunks.first);
+		}
+		catch(...)
+		{
+			error = std::current_exception();
+		}
+
+		// the partial results are reduced in the order of the chunks
+		for(auto& future : chunks.second)
+		{
+			wait(future);
+
+			try
+			{
+				if(!error)
+					result = Reduction(std::move(result), future.get());
+			}
+			catch(...)
+			{
+				error = std::current_exception();
+			}
+		}
+
+		if(error)
+			std::rethrow_exception(error);
+
+		return result;
+	}
+
+	template<typename REP, typename PERIOD>
+	ThreadPool::ShutdownReport ThreadPool::shutdown(bool drain, const std::chrono::duration<REP, PERIOD>& timeout)
+	{
+		return shutdown(drain, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+	}
+
+	template<typename REP, typename PERIOD>
+	bool ThreadPool::waitFor(const std::chrono::duration<REP, PERIOD>& timeout)
+	{
+		return waitUntil(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+	}
+
+	template<typename RESULT>
+	void ThreadPool::wait(const std::future<RESULT>& future)
+	{
+		// threads outside of the pool have nothing to help with, they just block
+		if(!isWorker())
+		{
+			future.wait();
+			return;
+		}
+
+		while(future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			// nothing to help with, the awaited job is running somewhere. Do not spin, but check
+			// regularly as the awaited job may add new jobs this thread could help with
+			if(!runPendingJob())
+				future.wait_for(std::chrono::microseconds(100));
+		}
+	}
+
+	template<typename RESULT>
+	RESULT ThreadPool::get(std::future<RESULT>& future)
+	{
+		wait(future);
+
+		return future.get();
+	}
 }
 
 #endif /* CORE_THREADPOOL_THREADPOOL_H_ */
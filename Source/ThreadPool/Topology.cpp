@@ -0,0 +1,176 @@
+/*
+ * Topology.cpp
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+/* Standard library inclusions */
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined( __linux__ )
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+/* Project specific inclusions */
+#include "ThreadPool/Topology.h"
+
+using namespace Core;
+
+namespace
+{
+	const char * const NodeDirectory = "/sys/devices/system/node/";
+
+	/* Parses the list in the sysfs format (e.g. "0-3,8-11"). Returns empty list if the file cannot be read */
+	CpuTopology::TCpus readList( const std::string & Path )
+	{
+		CpuTopology::TCpus tList;
+
+		std::ifstream tFile( Path );
+		std::string tRange;
+
+		while( std::getline( tFile, tRange, ',' ) )
+		{
+			std::istringstream tStream( tRange );
+
+			std::size_t tFirst = 0;
+			std::size_t tLast = 0;
+			char tDash = 0;
+
+			if( !( tStream >> tFirst ) )
+			{
+				continue;
+			}
+
+			tLast = ( ( tStream >> tDash >> tLast ) && ( tDash == '-' ) ) ? tLast : tFirst;
+
+			for( std::size_t tValue = tFirst; tValue <= tLast; ++tValue )
+			{
+				tList.push_back( tValue );
+			}
+		}
+
+		return( tList );
+	}
+
+	/* CPUs the process is allowed to run on */
+	CpuTopology::TCpus getAllowedCpus( void )
+	{
+		CpuTopology::TCpus tCpus;
+
+#if defined( __linux__ )
+		cpu_set_t tSet;
+
+		CPU_ZERO( & tSet );
+
+		if( sched_getaffinity( 0, sizeof( tSet ), & tSet ) == 0 )
+		{
+			for( std::size_t tCpu = 0; tCpu < CPU_SETSIZE; ++tCpu )
+			{
+				if( CPU_ISSET( tCpu, & tSet ) )
+				{
+					tCpus.push_back( tCpu );
+				}
+			}
+		}
+#endif
+
+		if( tCpus.empty() )
+		{
+			/* hardware_concurrency() may return 0 if the value is not computable */
+			for( std::size_t tCpu = 0; tCpu < std::max( std::thread::hardware_concurrency(), 1u ); ++tCpu )
+			{
+				tCpus.push_back( tCpu );
+			}
+		}
+
+		return( tCpus );
+	}
+}
+
+CORE_EXPORT CpuTopology CpuTopology::detect( void )
+{
+	CpuTopology tTopology;
+
+	TCpus tAllowed = getAllowedCpus();
+
+	for( std::size_t tNode : readList( std::string( NodeDirectory ) + "online" ) )
+	{
+		TCpus tCpus;
+
+		for( std::size_t tCpu : readList( std::string( NodeDirectory ) + "node" + std::to_string( tNode ) + "/cpulist" ) )
+		{
+			if( std::find( tAllowed.begin(), tAllowed.end(), tCpu ) != tAllowed.end() )
+			{
+				tCpus.push_back( tCpu );
+			}
+		}
+
+		if( !tCpus.empty() )
+		{
+			tTopology.mNodes.push_back( std::move( tCpus ) );
+		}
+	}
+
+	if( tTopology.mNodes.empty() )
+	{
+		tTopology.mNodes.push_back( std::move( tAllowed ) );
+	}
+
+	return( tTopology );
+}
+
+CORE_EXPORT std::size_t CpuTopology::getNode( std::size_t Cpu ) const
+{
+	for( std::size_t tNode = 0; tNode < this->mNodes.size(); ++tNode )
+	{
+		if( std::find( this->mNodes[ tNode ].begin(), this->mNodes[ tNode ].end(), Cpu ) != this->mNodes[ tNode ].end() )
+		{
+			return( tNode );
+		}
+	}
+
+	return( 0 );
+}
+
+CORE_EXPORT std::size_t CpuTopology::getCurrentCpu( void )
+{
+#if defined( __linux__ )
+	int tCpu = sched_getcpu();
+
+	if( tCpu >= 0 )
+	{
+		return( static_cast<std::size_t>( tCpu ) );
+	}
+#endif
+
+	return( UnknownCpu );
+}
+
+CORE_EXPORT bool CpuTopology::setAffinity( std::thread & Thread, const TCpus & Cpus )
+{
+#if defined( __linux__ )
+	cpu_set_t tSet;
+
+	CPU_ZERO( & tSet );
+
+	for( std::size_t tCpu : Cpus )
+	{
+		if( tCpu < CPU_SETSIZE )
+		{
+			CPU_SET( tCpu, & tSet );
+		}
+	}
+
+	return( pthread_setaffinity_np( Thread.native_handle(), sizeof( tSet ), & tSet ) == 0 );
+#else
+	static_cast<void>( Thread );
+	static_cast<void>( Cpus );
+
+	return( false );
+#endif
+}
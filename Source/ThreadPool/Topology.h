@@ -0,0 +1,91 @@
+/*
+ * Topology.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_TOPOLOGY_H_
+#define CORE_THREADPOOL_TOPOLOGY_H_
+
+/* Standard library inclusions */
+#include <cstddef>
+#include <limits>
+#include <thread>
+#include <vector>
+
+/* Shared library support */
+#include "Core_Export.h"
+
+/* As Core_Export.h header is generated during build, the required CORE_EXPORT
+ * definition might not exist due to missing header file. In order to prevent
+ * syntax errors cause by undefined CORE_EXPORT, define temporary blank one */
+#ifndef CORE_EXPORT
+	#define CORE_EXPORT
+	#define CORE_NO_EXPORT
+#endif
+
+namespace Core
+{
+	/**
+	 * @brief CPU topology
+	 *
+	 * NUMA nodes and the CPUs they consist of, restricted to the CPUs the process is allowed to run on. On Linux the
+	 * topology is read from /sys/devices/system/node. If it cannot be read (or on any other platform), the topology
+	 * consists of single node holding all the CPUs.
+	 *
+	 * Nodes are indexed from 0 in the order of the system node numbers, the nodes without any CPU available are left
+	 * out. CPUs are identified by the system CPU numbers.
+	 */
+	class CORE_EXPORT CpuTopology
+	{
+	public:
+		using TCpus = std::vector<std::size_t>;
+
+		static constexpr std::size_t UnknownCpu = std::numeric_limits<std::size_t>::max();
+
+		/**
+		 * @brief Detect the topology of the machine the process runs on
+		 */
+		static CpuTopology detect( void );
+
+		std::size_t getNodeCount( void ) const
+		{
+			return( this->mNodes.size() );
+		}
+
+		/**
+		 * @brief Get the CPUs of the node
+		 */
+		const TCpus & getCpus( std::size_t Node ) const
+		{
+			return( this->mNodes[ Node ] );
+		}
+
+		/**
+		 * @brief Get the node the CPU belongs to, 0 if the CPU is not known
+		 */
+		std::size_t getNode( std::size_t Cpu ) const;
+
+		/**
+		 * @brief Get the CPU the calling thread is running on
+		 *
+		 * @returns CPU number or UnknownCpu if it cannot be determined on this platform
+		 */
+		static std::size_t getCurrentCpu( void );
+
+		/**
+		 * @brief Restrict the thread to run on the given CPUs only
+		 *
+		 * @returns false if the affinity cannot be set (or is not supported on this platform)
+		 */
+		static bool setAffinity( std::thread & Thread, const TCpus & Cpus );
+
+	private:
+		CpuTopology( void ) = default;
+
+		std::vector<TCpus>	mNodes;
+	};
+}
+
+#endif /* CORE_THREADPOOL_TOPOLOGY_H_ */
@@ -0,0 +1,243 @@
+/*
+ * WorkStealingQueue.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: martin
+ */
+
+#ifndef CORE_THREADPOOL_WORKSTEALINGQUEUE_H_
+#define CORE_THREADPOOL_WORKSTEALINGQUEUE_H_
+
+/* Standard library inclusions */
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace Core
+{
+	namespace Detail
+	{
+		/**
+		 * @brief Work stealing job queue
+		 *
+		 * Double-ended job queue owned by a single ThreadPool worker. The owning worker pushes and pops
+		 * the jobs at the back (LIFO) so the most recently submitted (and most likely cache-hot) job is
+		 * executed first. Other workers steal from the front (FIFO) taking the oldest job available.
+		 *
+		 * Every queue has its own mutex so the workers do not contend on a single lock. The owner is the
+		 * only regular user of the queue, thieves just try to lock it and move on once it is busy.
+		 *
+		 * The jobs are stored in a ring buffer which only grows, so the queue stops allocating once it
+		 * reaches the size needed by the application.
+		 *
+		 * @tparam JOB	Default constructible, movable job type
+		 */
+		template<typename JOB>
+		class WorkStealingQueue
+		{
+		public:
+			/**
+			 * @brief Push the job at the back of the queue
+			 *
+			 * @param [in] Job	Job to be enqueued
+			 */
+			void push( JOB && Job )
+			{
+				std::lock_guard<std::mutex> lock( this->mJobsMutex );
+
+				if( this->mCount == this->mJobs.size() )
+				{
+					this->grow();
+				}
+
+				this->mJobs[ this->slot( this->mCount ) ] = std::move( Job );
+				++this->mCount;
+			}
+
+			/**
+			 * @brief Push all the jobs in the range at the back of the queue
+			 *
+			 * The jobs are moved out of the range under single lock.
+			 *
+			 * @param [in] First	Iterator to the first job to be enqueued
+			 * @param [in] Last		Iterator past the last job to be enqueued
+			 */
+			template<typename ITERATOR>
+			void push( ITERATOR First, ITERATOR Last )
+			{
+				std::lock_guard<std::mutex> lock( this->mJobsMutex );
+
+				for( ; First != Last; ++First )
+				{
+					if( this->mCount == this->mJobs.size() )
+					{
+						this->grow();
+					}
+
+					this->mJobs[ this->slot( this->mCount ) ] = std::move( *First );
+					++this->mCount;
+				}
+			}
+
+			/**
+			 * @brief Push all the jobs in the range at the front of the queue
+			 *
+			 * The jobs keep their order, the first one becomes the oldest job of the queue.
+			 *
+			 * @param [in] First	Iterator to the first job to be enqueued
+			 * @param [in] Last		Iterator past the last job to be enqueued
+			 */
+			template<typename ITERATOR>
+			void pushFront( ITERATOR First, ITERATOR Last )
+			{
+				std::lock_guard<std::mutex> lock( this->mJobsMutex );
+
+				while( First != Last )
+				{
+					if( this->mCount == this->mJobs.size() )
+					{
+						this->grow();
+					}
+
+					this->mFront = this->slot( this->mJobs.size() - 1 );
+					this->mJobs[ this->mFront ] = std::move( *--Last );
+					++this->mCount;
+				}
+			}
+
+			/**
+			 * @brief Pop the most recently pushed job (owner side)
+			 *
+			 * @param [out] Job		Job taken out of the queue
+			 *
+			 * @returns true	{Job was taken}
+			 * @returns false	{Queue is empty}
+			 */
+			bool pop( JOB & Job )
+			{
+				std::lock_guard<std::mutex> lock( this->mJobsMutex );
+
+				if( this->mCount == 0 )
+				{
+					return( false );
+				}
+
+				--this->mCount;
+				Job = std::move( this->mJobs[ this->slot( this->mCount ) ] );
+
+				return( true );
+			}
+
+			/**
+			 * @brief Steal the oldest job (thief side)
+			 *
+			 * The queue is not waited for if locked by anybody else. It is cheaper for the thief to try
+			 * another victim than to wait for this one.
+			 *
+			 * @param [out] Job		Job taken out of the queue
+			 *
+			 * @returns true	{Job was stolen}
+			 * @returns false	{Queue is empty or busy}
+			 */
+			bool steal( JOB & Job )
+			{
+				std::unique_lock<std::mutex> lock( this->mJobsMutex, std::try_to_lock );
+
+				if( ( !lock.owns_lock() ) || ( this->mCount == 0 ) )
+				{
+					return( false );
+				}
+
+				Job = std::move( this->mJobs[ this->mFront ] );
+				this->mFront = this->slot( 1 );
+				--this->mCount;
+
+				return( true );
+			}
+
+			/**
+			 * @brief Move all the jobs at the back of the vector, the oldest first
+			 *
+			 * @param [out] Jobs	Vector the jobs are appended to
+			 */
+			void takeAll( std::vector<JOB> & Jobs )
+			{
+				std::lock_guard<std::mutex> lock( this->mJobsMutex );
+
+				for( ; this->mCount > 0; --this->mCount )
+				{
+					Jobs.push_back( std::move( this->mJobs[ this->mFront ] ) );
+					this->mFront = this->slot( 1 );
+				}
+			}
+
+			/**
+			 * @brief Number of jobs in the queue
+			 */
+			std::size_t size( void ) const
+			{
+				std::lock_guard<std::mutex> lock( this->mJobsMutex );
+
+				return( this->mCount );
+			}
+
+			/**
+			 * @brief Drop all the jobs in the queue
+			 *
+			 * @returns Number of jobs dropped
+			 */
+			std::size_t clear( void )
+			{
+				std::lock_guard<std::mutex> lock( this->mJobsMutex );
+
+				std::size_t tDropped = this->mCount;
+
+				/* Release the jobs but keep the buffer */
+				for( ; this->mCount > 0; --this->mCount )
+				{
+					this->mJobs[ this->slot( this->mCount - 1 ) ] = JOB();
+				}
+
+				return( tDropped );
+			}
+
+		private:
+			/* Index of the buffer slot at Position counted from the front */
+			std::size_t slot( std::size_t Position ) const
+			{
+				return( ( this->mFront + Position ) & ( this->mJobs.size() - 1 ) );
+			}
+
+			/* Doubles the buffer capacity, moving the jobs to the beginning of the new buffer */
+			void grow( void )
+			{
+				std::vector<JOB> tJobs( std::max<std::size_t>( 2 * this->mJobs.size(), InitialCapacity ) );
+
+				for( std::size_t tPosition = 0; tPosition < this->mCount; ++tPosition )
+				{
+					tJobs[ tPosition ] = std::move( this->mJobs[ this->slot( tPosition ) ] );
+				}
+
+				this->mJobs.swap( tJobs );
+				this->mFront = 0;
+			}
+
+			/* Buffer capacity must be power of two */
+			static constexpr std::size_t InitialCapacity = 16;
+
+			/* Ring buffer of the jobs */
+			std::vector<JOB>	mJobs;
+
+			/* Index of the oldest job */
+			std::size_t			mFront = 0;
+
+			/* Number of jobs in the queue */
+			std::size_t			mCount = 0;
+
+			/* The mutex must be made 'mutable' in order to allow it's modification in 'const' functions */
+			mutable std::mutex	mJobsMutex;
+		};
+	}
+}
+
+#endif /* CORE_THREADPOOL_WORKSTEALINGQUEUE_H_ */